@@ -14,13 +14,13 @@ class AnimatedTexture: public Texture
 {
 	public:
 		/** Create an animated texture.
-		 * @param pointerSDLTexture The SDL texture to use.
+		 * @param pointerTexture The still texture containing all images side by side.
 		 * @param imagesCount How many single images are present in the provided texture.
-		 * @param framesPerImageCount How many game frames to wait between each single image displaying.
+		 * @param framesPerImageCount How many game ticks to wait between each single image displaying (the duration of a game tick is CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS).
 		 * @param isAnimationLooping Set to true to make the animation loop forever, set to false to display the animation only once.
 		 * @note Texture starts playing from the first image.
 		 */
-		AnimatedTexture(SDL_Texture *pointerSDLTexture, int imagesCount, int framesPerImageCount, bool isAnimationLooping);
+		AnimatedTexture(Texture *pointerTexture, int imagesCount, int framesPerImageCount, bool isAnimationLooping);
 		
 		/** Free allocated resources. */
 		virtual ~AnimatedTexture() {}
@@ -33,16 +33,22 @@ class AnimatedTexture: public Texture
 		 */
 		virtual int render(int x, int y);
 	
+		/** Tell whether the animation finished playing, even if the texture was not rendered for some time.
+		 * @return true if the last image display time is elapsed (never for a looping animation),
+		 * @return false if the animation is still playing.
+		 */
+		bool isAnimationTerminated();
+	
 	protected:
 		/** How many static images are contained in the provided image file. */
 		int _imagesCount;
 		/** The currently displayed image. */
 		int _currentImageIndex;
 		
-		/** How much time each static image must be displayed on the screen. Time is computed taking into account engine frames per second. */
-		int _framesPerImageCount;
-		/** Incremented by one on each engine frame, tell when to display the next texture. */
-		int _framesCounter;
+		/** How much time each static image must be displayed on the screen (in simulation milliseconds). */
+		unsigned int _imageDisplayingDuration;
+		/** When the currently displayed image started being displayed (in simulation milliseconds). */
+		unsigned int _currentImageStartingTime;
 		
 		/** Tell whether animation should loop forever or stop when the last frame has been displayed. */
 		bool _isAnimationLooping;
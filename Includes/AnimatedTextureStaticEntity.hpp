@@ -26,15 +26,11 @@ class AnimatedTextureStaticEntity: public StaticEntity
 		// No need for documentation because it is the same as parent function
 		virtual void render();
 		
-		/** Tell whether the animation finished playing.
+		/** Tell whether the animation finished playing. The animation time elapses even when the entity is not rendered (because it is not visible), so the entity is always destroyed in time.
 		 * @return 0 while the animation must be displayed,
 		 * @return 1 when the animation is finished and the object must be destroyed.
 		 */
 		virtual int update();
-
-	private:
-		/** Tell whether the animation finished playing. */
-		int _isAnimationTerminated;
 };
 
 #endif
@@ -42,10 +42,11 @@ namespace AudioManager
 	} SoundId;
 
 	/** Load all game sounds.
+	 * @param isAudioEnabled Set to false to open no audio device and load no file, all playing functions will then do nothing.
 	 * @return 0 if all files were successfully loaded,
 	 * @return -1 if an error occurred.
 	 */
-	int initialize();
+	int initialize(bool isAudioEnabled);
 
 	/** Free all allocated resources. */
 	void uninitialize();
@@ -19,8 +19,24 @@
 #define CONFIGURATION_DISPLAY_WIDTH 1024
 /** Display height in pixels (only in windowed mode). */
 #define CONFIGURATION_DISPLAY_HEIGHT 768
-/** Display refresh period (for a 60Hz refresh frequency, the period is 1/60 = 0.016ms). */
-#define CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS 16
+/** How long before the next frame time the frame rate limiter stops sleeping and actively waits, in microseconds (the operating system can wake a sleeping thread up more than one millisecond late). */
+#define CONFIGURATION_DISPLAY_FRAME_LIMITER_SPIN_DURATION_MICROSECONDS 2000
+/** The maximum width and height in pixels of a texture atlas, all images are packed in as few atlases as possible so the renderer rarely needs to switch textures (all graphics cards support 2048x2048 textures). */
+#define CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SIZE 2048
+/** How many transparent pixels separate two images in a texture atlas, so a scaled image does not show its neighbors borders. */
+#define CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING 1
+/** The lowest resolution the game world can be drawn at when the render scale is automatically adjusted, in percentage of the display resolution. */
+#define CONFIGURATION_DISPLAY_RENDER_SCALE_MINIMUM_PERCENTAGE 50
+/** How much the automatic render scale changes at once, in percentage of the display resolution. */
+#define CONFIGURATION_DISPLAY_RENDER_SCALE_STEP_PERCENTAGE 10
+/** How many frames are measured before the automatic render scale is adjusted. */
+#define CONFIGURATION_DISPLAY_RENDER_SCALE_MEASURED_FRAMES_COUNT 120
+/** The automatic render scale is lowered when more than this percentage of the measured frames are late (a frame is late when it missed a display refresh although the game recorded it in time). */
+#define CONFIGURATION_DISPLAY_RENDER_SCALE_MAXIMUM_LATE_FRAMES_PERCENTAGE 5
+/** The automatic render scale is raised when no frame was late during this amount of successive measurements, so the resolution does not often go back to a too high value. */
+#define CONFIGURATION_DISPLAY_RENDER_SCALE_RAISING_MEASUREMENTS_COUNT 8
+/** The display refresh rate to consider when the display does not tell it, in frames per second. */
+#define CONFIGURATION_DISPLAY_DEFAULT_REFRESH_RATE 60
 /** HUD background texture screen X coordinate. */
 #define CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_X 10
 /** HUD background texture screen Y coordinate. */
@@ -51,6 +67,8 @@
 #define CONFIGURATION_MENU_ITEM_STRINGS_VERTICAL_SPACING 60
 /** Menu title vertical coordinate. */
 #define CONFIGURATION_MENU_TITLE_Y 10
+/** How long to wait for a player input before checking the menu state again, in milliseconds (a menu is drawn again only when its content changes). */
+#define CONFIGURATION_MENU_EVENTS_WAITING_TIMEOUT 500
 
 // Audio
 /** Sampling frequency in Hz. */
@@ -58,6 +76,24 @@
 /** How many sounds can be played simultaneously. */
 #define CONFIGURATION_AUDIO_CHANNELS_COUNT 48
 
+// Jobs
+/** The maximum amount of worker threads, whatever the processor cores count. */
+#define CONFIGURATION_JOBS_MAXIMUM_WORKER_THREADS_COUNT 16
+/** How many items a thread processes each time it takes work (larger values reduce synchronization, smaller values spread the work more evenly). */
+#define CONFIGURATION_JOBS_PARALLEL_FOR_CHUNK_SIZE 32
+/** How many jobs each thread queue can hold (jobs submitted to a full queue are immediately run by the submitting thread). */
+#define CONFIGURATION_JOBS_QUEUE_SIZE 1024
+/** How many jobs can wait for the same group of jobs to finish. */
+#define CONFIGURATION_JOBS_MAXIMUM_DEPENDENT_JOBS_COUNT 8
+
+// Timers
+/** How many wheels the timing wheel is made of. Timers expiring later than the wheels can count are moved to the last wheel again each time it turns. */
+#define CONFIGURATION_TIMERS_WHEELS_COUNT 4
+/** How many slots the first wheel contains, as a power of two. Each slot of the first wheel lasts one millisecond. */
+#define CONFIGURATION_TIMERS_FIRST_WHEEL_SLOTS_COUNT_BITS 8
+/** How many slots each following wheel contains, as a power of two. A slot lasts as long as a whole turn of the previous wheel. */
+#define CONFIGURATION_TIMERS_OTHER_WHEELS_SLOTS_COUNT_BITS 6
+
 // Logs
 /** The log file name. */
 #define CONFIGURATION_LOG_FILE_NAME "Log.txt"
@@ -78,8 +114,24 @@
 #define CONFIGURATION_LEVEL_BLOCK_SIZE 64
 /** How many levels are available. */
 #define CONFIGURATION_LEVELS_COUNT 7
+/** The stress test arena width and height in blocks. */
+#define CONFIGURATION_LEVEL_STRESS_TEST_ARENA_SIZE 96
+
+// Navigation
+/** The width and height in blocks of the clusters the level is divided in to find the paths to the player. */
+#define CONFIGURATION_NAVIGATION_CLUSTER_SIZE 16
+/** How many blocks of a wide opening between two clusters are crossed by a single portal. */
+#define CONFIGURATION_NAVIGATION_PORTALS_SPACING 4
+
+// Visibility
+/** The width and height in blocks of the cells the level is divided in to find the entities to render. A cell must be larger than the biggest entity, because only the cells on the left of and above the display are visited in addition to the cells covered by the display. */
+#define CONFIGURATION_VISIBILITY_CELL_SIZE 4
 
 // Gameplay
+/** The duration of a game update step (tick). The game logic is updated at this fixed rate whatever the display refresh rate is, the displayed frames are interpolated between ticks. */
+#define CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS 16
+/** How many ticks can be simulated before displaying a frame when the game is late (a slow computer slows the game down instead of never catching up). */
+#define CONFIGURATION_GAMEPLAY_MAXIMUM_TICKS_PER_FRAME 4
 /** The probability (in range 0% to 100%) to spawn a medipack when an enemy dies. */
 #define CONFIGURATION_GAMEPLAY_MEDIPACK_ITEM_SPAWN_PROBABILITY_PERCENTAGE 10
 /** The probability (in range 0% to 100%) to spawn ammunition when an enemy dies. */
@@ -130,6 +182,14 @@
 /** The offset to add to player top side when spawning the "mortar shell muzzle flash" effect while the player is facing right. */
 #define CONFIGURATION_PLAYER_MUZZLE_FLASH_MORTAR_SHELL_FACING_RIGHT_STARTING_POSITION_OFFSET_Y 4
 
+// Enemy entities
+/** Enemies closer to the player than half a display plus this distance (in pixels) choose their action on every tick, because the player can enter their shooting areas at any time. */
+#define CONFIGURATION_ENEMY_AI_NEAR_TIER_MARGIN 128
+/** How many enemies that are not near the player but can spot it choose their action on each tick. They choose in turn and repeat their previous action meanwhile. */
+#define CONFIGURATION_ENEMY_AI_MEDIUM_TIER_DECISIONS_PER_TICK 16
+/** How many enemies too far to spot the player look for it on each tick. They look in turn and repeat their previous action meanwhile. */
+#define CONFIGURATION_ENEMY_AI_FAR_TIER_DECISIONS_PER_TICK 4
+
 // Bullet entities
 /** The offset to add to the bullet X and Y positions (whatever direction the bullet is facing) when adding a bullet explosion effect. */
 #define CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET (-20)
@@ -39,6 +39,12 @@ namespace ControlManager
 	*/
 	bool isKeyPressed(KeyId keyId);
 
+	/** Force a key state, whatever the physical devices state is (this is used to replay recorded inputs).
+	* @param keyId The key to set state.
+	* @param isPressed Set to true to press the key, set to false to release it.
+	*/
+	void setKeyPressed(KeyId keyId, bool isPressed);
+
 	/** Handle a SDL event related to the keyboard.
 	* @param pointerEvent The keyboard event.
 	*/
@@ -54,6 +60,11 @@ namespace ControlManager
 	* @return false if the direction was horizontal.
 	*/
 	bool isLastPressedDirectionKeyOnVerticalAxis();
+
+	/** Force the axis of the last pressed direction key (this is used to replay recorded inputs).
+	* @param isVerticalAxis Set to true for the vertical axis, set to false for the horizontal axis.
+	*/
+	void setLastPressedDirectionKeyOnVerticalAxis(bool isVerticalAxis);
 }
 
 #endif
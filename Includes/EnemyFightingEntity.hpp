@@ -48,7 +48,17 @@ class EnemyFightingEntity: public FightingEntity
 		// No need for documentation because it is the same as parent function
 		virtual int moveToRight();
 		
-		/** Update enemy artificial intelligence.
+		/** Choose what the enemy will do on next update() call. This function only reads the game state, so it can be called simultaneously for all enemies.
+		 * @note Must be called before update(), after the player and the enemies life have been modified by the bullets.
+		 */
+		void decide();
+		
+		/** Keep the action chosen by the last decide() call without looking at the player again, this is much cheaper than decide() for the enemies far from the player.
+		 * @note Must be called instead of decide(), shooting is not repeated because the player may have left the line of sight.
+		 */
+		void repeatDecision();
+		
+		/** Apply the action chosen by decide() (moving updates the blocks content, so enemies must be updated one after the other).
 		 * @return 0 if the enemy must be kept alive,
 		 * @return 1 if the enemy is dead and must be removed,
 		 * @return 2 if the enemy is alive and wants to shoot (call the shoot() method).
@@ -59,38 +69,82 @@ class EnemyFightingEntity: public FightingEntity
 		virtual void render();
 
 	protected:
+		/** All actions an enemy can decide to do. */
+		typedef enum
+		{
+			ACTION_IDLE, //!< The player is not spotted, do nothing.
+			ACTION_WAIT, //!< The player is spotted but the enemy can't shoot it nor come closer.
+			ACTION_SHOOT, //!< Shoot the player.
+			ACTION_MOVE //!< Move toward the player.
+		} Action;
+		
 		/** The player will be spotted by the enemy if he enters this area. */
 		SDL_Rect _spottingRectangle;
 		
 		/** The enemy will shoot if the player enters one of these rectangles. */
 		SDL_Rect _shootingRectangles[DIRECTIONS_COUNT];
 		
-		/** Tell if a replacement direction has been chosen or not. */
-		int _isReplacementDirectionChosen;
-		/** The direction to use when the player direction is blocked by a wall. */
+		/** How many ticks the enemy still moves to the replacement direction before trying the player direction again. */
+		int _replacementDirectionTicksCount;
+		/** The direction to use when the player direction is blocked by another enemy. */
 		Direction _replacementDirection;
 		
 		/** The effect to generate when the enemy explodes. */
 		EffectManager::EffectId _explosionEffectId;
 
+		/** The action chosen by decide(). */
+		Action _decidedAction;
+		/** The direction to face before doing the decided action (the enemy turns to the player when it is in a shooting area). */
+		Direction _decidedFacingDirection;
+		/** The direction to move to when the decided action is to move. */
+		Direction _decidedMovingDirection;
+
 	private:
 		/** Tell if the enemy can shoot the player or not.
+		 * @param pointerFacingDirection On input, contain the enemy facing direction. On output, contain the direction the enemy must face to shoot the player if it is in a shooting area.
 		 * @return 1 if the enemy can shoot,
 		 * @return 0 if the player is out of range.
 		 */
-		int _isShootPossible();
+		int _isShootPossible(Direction *pointerFacingDirection);
 		
 		/** Tell in which direction to go to reach the player.
+		 * @param facingDirection The direction the enemy will face when moving.
 		 * @param pointerDirection On output, contain the player direction.
 		 * @return 1 if the enemy should move,
 		 * @return 0 if the enemy can remain still.
 		 */
-		int _getPlayerDirection(Direction *pointerDirection);
+		int _getPlayerDirection(Direction facingDirection, Direction *pointerDirection);
 		
-		/** Set or reset a block flag telling whether an enemy is present on the block.
-		 * @param isEnemyPresent Set to true to set the flag, set to false to reset the flag.
+		/** Tell in which direction to go to follow the shortest path to the player, computed by NavigationManager::updatePlayerDistances().
+		 * @param pointerEnemyPositionRectangle The enemy position rectangle matching the direction it will face when moving.
+		 * @param isHorizontalAxisPreferred Set to true to prefer a horizontal move when several directions are as close to the player, set to false to prefer a vertical move.
+		 * @return The direction to move to.
+		 * @note The enemy block must be able to reach the player.
 		 */
-		void _setBlockEnemyContent(bool isEnemyPresent);
+		Direction _getPathDirection(SDL_Rect *pointerEnemyPositionRectangle, bool isHorizontalAxisPreferred);
+		
+		/** Get the point of a neighbor block matching a point of a block.
+		 * @param x The X coordinate in pixels of a point in the starting block.
+		 * @param y The Y coordinate in pixels of a point in the starting block.
+		 * @param direction Where the neighbor block is.
+		 * @param pointerNeighborX On output, contain the X coordinate of the same point in the neighbor block.
+		 * @param pointerNeighborY On output, contain the Y coordinate of the same point in the neighbor block.
+		 */
+		void _getNeighborBlockPoint(int x, int y, Direction direction, int *pointerNeighborX, int *pointerNeighborY);
+		
+		/** Choose where to go when another enemy is in the way, favoring the free blocks close to the player and far from the other enemies.
+		 * @param blockedDirection The direction the enemy can't move to.
+		 * @param pointerDirection On output, contain the direction to move to.
+		 * @return 1 if a direction has been found,
+		 * @return 0 if all neighbor blocks are taken.
+		 */
+		int _getAvoidanceDirection(Direction blockedDirection, Direction *pointerDirection);
+		
+		/** Count the enemy on the block located under its center. */
+		void _addToBlock();
+		
+		/** Stop counting the enemy on the block located under its center. */
+		void _removeFromBlock();
 };
 
 #endif
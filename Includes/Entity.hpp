@@ -5,6 +5,7 @@
 #define HPP_ENTITY_HPP
 
 #include <SDL2/SDL.h>
+#include <VisibilityManager.hpp>
 
 /** @class Entity
  * Base class for all game entities.
@@ -12,8 +13,14 @@
 class Entity
 {
 	public:
+		/** The node storing the entity in VisibilityManager cells, or -1 if the entity is not stored. */
+		int visibilityNodeIndex;
+		
+		/** Initialize the entity as not visible. */
+		Entity(): visibilityNodeIndex(-1) {}
+		
 		/** Free allocated resources. */
-		virtual ~Entity() {}
+		virtual ~Entity() { VisibilityManager::removeEntity(this); }
 		
 		/** Update the internal entity logic.
 		 * @return 0 if the entity must be kept alive,
@@ -21,6 +28,9 @@ class Entity
 		 */
 		virtual int update() = 0;
 		
+		/** Display the entity at its map location. */
+		virtual void render() = 0;
+		
 		/** Get the entity X coordinate.
 		 * @return The X coordinate.
 		 */
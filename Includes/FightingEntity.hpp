@@ -108,10 +108,14 @@ class FightingEntity: public MovingEntity
 		/** Offset to add to entity coordinates to put the shoot firing effect in front of the entity cannon. */
 		SDL_Point _firingEffectStartingPositionOffsets[DIRECTIONS_COUNT]; // Offsets are in the same order than Direction enum
 		
-		/** When was the last shot fired (in milliseconds). This is part of the fire rate mechanism. */
+		/** When was the last shot fired (in simulation milliseconds). This is part of the fire rate mechanism. */
 		unsigned int _lastShotTime;
-		/** How many milliseconds to wait between two shots. */
+		/** How many milliseconds to wait between two shots. Call _updateReloadingTimer() after changing it. */
 		unsigned int _timeBetweenShots;
+		/** Tell whether the time between two shots has elapsed since the last shot. */
+		bool _isReloadingTimeElapsed;
+		/** The timer telling when the reloading time elapses, or TimerManager::TIMER_ID_NONE if the entity is not reloading. */
+		int _reloadingTimerId;
 		
 		/** The effect to play when the entity shoots. */
 		EffectManager::EffectId _firingEffectId;
@@ -136,6 +140,15 @@ class FightingEntity: public MovingEntity
 		 * @param pointerPositionOffsets On output, contain the computed offsets.
 		 */
 		void _computeFiringEffectStartingPositionOffsets(Texture *pointerEntityTexture, EffectManager::EffectId firingEffectId, SDL_Point *pointerPositionOffsets);
+		
+		/** Schedule the end of the reloading time according to the last shot time and to the time between two shots, so the fire rate does not need to be checked on each shot attempt. */
+		void _updateReloadingTimer();
+	
+	private:
+		/** Called when the reloading time has elapsed.
+		 * @param pointerParameter The entity that has reloaded.
+		 */
+		static void _reloadingTimerCallback(void *pointerParameter);
 };
 
 #endif
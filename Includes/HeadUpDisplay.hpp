@@ -52,6 +52,9 @@ namespace HeadUpDisplay
 	 */
 	void setCompassArrowState(CompassArrowId id, bool isLighted);
 
+	/** Draw the panel again on next render() call even if no string changed, because the renderer lost the content of the textures it draws to. */
+	void setPanelRedrawNeeded();
+
 	/** Render the strings with the last provided values to the screen. */
 	void render();
 }
@@ -0,0 +1,85 @@
+/** @file JobManager.hpp
+ * Spread independent computations over all processor cores using a pool of worker threads. Each thread owns a queue of jobs, a thread running out of jobs steals some from the other threads queues.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_JOB_MANAGER_HPP
+#define HPP_JOB_MANAGER_HPP
+
+#include <Configuration.hpp>
+#include <SDL2/SDL.h>
+
+namespace JobManager
+{
+	struct JobCounter;
+
+	/** A function run by any thread.
+	* @param pointerParameter The parameter given when submitting the job.
+	*/
+	typedef void (*JobFunction)(void *pointerParameter);
+
+	/** A function processing a range of items.
+	* @param pointerParameter The parameter given to parallelFor().
+	* @param firstItemIndex The first item to process.
+	* @param itemsCount How many consecutive items to process.
+	*/
+	typedef void (*ParallelForFunction)(void *pointerParameter, int firstItemIndex, int itemsCount);
+
+	/** A job waiting to be run. */
+	typedef struct
+	{
+		JobFunction pointerFunction; //!< The function to call.
+		void *pointerParameter; //!< The parameter to give to the function.
+		struct JobCounter *pointerCounter; //!< Decremented when the job is finished, can be NULL.
+	} Job;
+
+	/** Count the unfinished jobs of a group, so the group can be waited for or other jobs can be started when the whole group is finished. */
+	typedef struct JobCounter
+	{
+		SDL_atomic_t unfinishedJobsCount; //!< How many jobs of the group are submitted but not finished yet.
+		SDL_SpinLock lock; //!< Protect the dependent jobs.
+		Job dependentJobs[CONFIGURATION_JOBS_MAXIMUM_DEPENDENT_JOBS_COUNT]; //!< The jobs to submit when all jobs of the group are finished.
+		int dependentJobsCount; //!< How many dependent jobs are waiting.
+	} JobCounter;
+
+	/** Start one worker thread per additional processor core.
+	* @return 0 if all went successful,
+	* @return -1 if an error occurred.
+	*/
+	int initialize();
+
+	/** Stop all worker threads. */
+	void uninitialize();
+
+	/** Prepare a counter for a new group of jobs.
+	* @param pointerCounter The counter to reset. It must not be used by unfinished jobs.
+	*/
+	void initializeCounter(JobCounter *pointerCounter);
+
+	/** Queue a job, it is run later by the calling thread or by any worker thread.
+	* @param pointerFunction The function to run.
+	* @param pointerParameter A value forwarded to the function.
+	* @param pointerCounter The counter of the group the job belongs to, set to NULL if nobody needs to know when the job is finished.
+	* @param pointerDependencyCounter Set to a counter to run the job only when all jobs of this counter are finished, set to NULL to run the job as soon as possible.
+	*/
+	void submitJob(JobFunction pointerFunction, void *pointerParameter, JobCounter *pointerCounter, JobCounter *pointerDependencyCounter);
+
+	/** Wait for all jobs of a group to be finished. The calling thread runs queued jobs meanwhile, so jobs can wait for other jobs too.
+	* @param pointerCounter The counter of the group to wait for.
+	*/
+	void waitForCounter(JobCounter *pointerCounter);
+
+	/** Call a function on all items, the items being processed simultaneously by the worker threads and the calling thread. The function returns when all items have been processed.
+	* @param itemsCount How many items to process.
+	* @param pointerFunction The function to call on each range of items. It must not modify anything that other items can read.
+	* @param pointerParameter A value forwarded to the function.
+	* @note Small item counts are directly processed by the calling thread, because waking the workers would cost more than the processing.
+	*/
+	void parallelFor(int itemsCount, ParallelForFunction pointerFunction, void *pointerParameter);
+
+	/** Get how many threads can process items simultaneously.
+	* @return The worker threads count plus one for the calling thread.
+	*/
+	int getThreadsCount();
+}
+
+#endif
@@ -7,6 +7,7 @@
 
 #include <EnemySpawnerStaticEntity.hpp>
 #include <list>
+#include <MovingEntity.hpp>
 
 namespace LevelManager
 {
@@ -19,7 +20,7 @@ namespace LevelManager
 		BLOCK_CONTENT_AMMUNITION = 1 << 3, //!< If set, tell that ammunition are present on top of this block.
 		BLOCK_CONTENT_MACHINE_GUN_BONUS = 1 << 4, //!< If set, tell that a machine gun bonus is present on top of this block.
 		BLOCK_CONTENT_BULLETPROOF_VEST_BONUS = 1 << 5, //!< If set, tell that a bulletproof vest bonus is present on top of this block.
-		BLOCK_CONTENT_ENEMY = 1 << 6, //!< If set, tell that an enemy is walking on this block, so no other enemy can go through this block to avoid collisions.
+		BLOCK_CONTENT_ENEMY = 1 << 6, //!< If set, tell that at least one enemy is walking on this block, so no other enemy can go through this block to avoid collisions. Use addBlockEnemy() and removeBlockEnemy() to change it.
 		BLOCK_CONTENT_ENEMY_SPAWNER = 1 << 7, //!< If set, tell that the whole block is occupied by an enemy spawner. Player and enemies can't cross the block, but bullets can.
 		BLOCK_CONTENT_LEVEL_EXIT = 1 << 8 //!< If set and the player walks on it, the game will load the next level.
 	} BlockContent;
@@ -43,6 +44,14 @@ namespace LevelManager
 	 */
 	int loadLevel(int levelNumber);
 
+	/** Create a square arena surrounded by walls and scattered with pillars, put the player at its center and randomly place enemy spawners. This is used to load the engine with as many entities as needed.
+	 * @param sizeBlocks The arena width and height in blocks.
+	 * @param enemySpawnersCount How many enemy spawners to place. Less spawners can be placed if there is not enough room.
+	 * @return -1 if an error occurred,
+	 * @return 0 if the arena was successfully generated.
+	 */
+	int generateArena(int sizeBlocks, int enemySpawnersCount);
+
 	/** Display the scene (decor) to the main renderer.
 	 * @param topLeftX This is the scene horizontal coordinate to start drawing from.
 	 * @param topLeftY This is the scene vertical coordinate to start drawing from.
@@ -81,7 +90,7 @@ namespace LevelManager
 	 */
 	int getDistanceFromRightmostBlock(int x, int y, int blockContent);
 
-	/** Tell if there is an obstacle (wall, enemy spawner...) on the vertical axis between two specified points.
+	/** Tell if there is an obstacle (wall, enemy spawner...) on the vertical axis between two specified points. The rows and columns are cut into segments free of obstacles, so this takes the same time whatever the distance is.
 	 * @param topmostY The topmost point Y coordinate.
 	 * @param downerY The downer point Y coordinate.
 	 * @param x The horizontal coordinate, which is the same for the two points.
@@ -90,7 +99,7 @@ namespace LevelManager
 	 */
 	bool isObstaclePresentOnVerticalAxis(int topmostY, int downerY, int x);
 
-	/** Tell if there is an obstacle (wall, enemy spawner...) on the horizontal axis between two specified points.
+	/** Tell if there is an obstacle (wall, enemy spawner...) on the horizontal axis between two specified points. The rows and columns are cut into segments free of obstacles, so this takes the same time whatever the distance is.
 	 * @param leftmostX The leftmost point X coordinate.
 	 * @param rightmostX The rightmost point X coordinate.
 	 * @param y The vertical coordinate, which is the same for the two points.
@@ -113,6 +122,44 @@ namespace LevelManager
 	 */
 	void setBlockContent(int x, int y, int content);
 	
+	/** Set the block the enemy spawners directions are counted from. The counts are moved only across the rows and columns separating the block from the previous reference one, so this takes a constant time when the reference block follows the player.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 */
+	void setEnemySpawnersReferenceBlock(int x, int y);
+	
+	/** Get how many enemy spawners are located in a direction from the reference block (a spawner is above the block if its row is above the block row, whatever its column is). The counts are kept up to date when spawners are removed.
+	 * @param direction The direction to look at.
+	 * @return The enemy spawners count.
+	 */
+	int getEnemySpawnersCount(MovingEntity::Direction direction);
+
+	/** Tell that an enemy center entered a block. The block BLOCK_CONTENT_ENEMY flag is set.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 */
+	void addBlockEnemy(int x, int y);
+
+	/** Tell that an enemy center left a block. The block BLOCK_CONTENT_ENEMY flag is cleared when no other enemy is on the block.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 */
+	void removeBlockEnemy(int x, int y);
+
+	/** Get how many enemy centers are on a block.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 * @return The enemies count.
+	 */
+	int getBlockEnemiesCount(int x, int y);
+
+	/** Get how many enemy centers are on a block and on the 8 blocks around it.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 * @return The enemies count.
+	 */
+	int getSurroundingEnemiesCount(int x, int y);
+
 	/** Spawn a random item (or nothing) on the block into which coordinates are contained.
 	 * @param x X coordinate in pixels.
 	 * @param y Y coordinate in pixels.
@@ -13,7 +13,7 @@ namespace Menu
 	* @param menuItemsCount How many menu items to display.
 	* @return -1 if the user pressed Alt+F4 or closed the window,
 	* @return 0 or a positive number representing the index of the selected menu item. Index are in the pointerStringsMenuItemsTexts parameters order.
-	* @note As strings' coordinates are computed each time this function is called, the function can be used as-is in an in-game window resizing engine.
+	* @note The strings textures are rendered the first time a menu is displayed, then they are kept for the next times.
 	*/
 	int display(const char *pointerStringMenuTitle, const char *pointerStringsMenuItemsTexts[], int menuItemsCount);
 	
@@ -22,6 +22,9 @@ namespace Menu
 	 * @return 0 if the user exited from the menu.
 	 */
 	int displayControlsMenu();
+
+	/** Free the textures of all menus that have been displayed. */
+	void uninitialize();
 }
 
 #endif
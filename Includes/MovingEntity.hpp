@@ -55,6 +55,16 @@ class MovingEntity: public Entity
 		 */
 		virtual void setY(int y);
 		
+		/** Get the X coordinate to display the entity at, it is interpolated between the position before the last tick and the current one using Renderer::interpolationFactor.
+		 * @return The displaying X coordinate.
+		 */
+		int getInterpolatedX();
+		
+		/** Get the Y coordinate to display the entity at, it is interpolated between the position before the last tick and the current one using Renderer::interpolationFactor.
+		 * @return The displaying Y coordinate.
+		 */
+		int getInterpolatedY();
+		
 		/** Get a rectangle defining the entity bounds in the map.
 		 * @return The position rectangle.
 		 */
@@ -115,6 +125,16 @@ class MovingEntity: public Entity
 		Texture *_pointerTextures[DIRECTIONS_COUNT];
 		/** All entity collision rectangles (one for each direction). */
 		SDL_Rect _positionRectangles[DIRECTIONS_COUNT];
+		
+		/** The entity X coordinate before it moved during the tick the position was stored. */
+		int _previousX;
+		/** The entity Y coordinate before it moved during the tick the position was stored. */
+		int _previousY;
+		/** The tick the previous position was stored during. */
+		unsigned int _previousPositionTicksCount;
+		
+		/** Store the entity position before it moves for the first time during the current tick, so it can be displayed at an interpolated position. */
+		void _keepPreviousPosition();
 };
 
 #endif
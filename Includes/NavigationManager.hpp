@@ -0,0 +1,46 @@
+/** @file NavigationManager.hpp
+ * Find the shortest paths from all level blocks to the player. The level is divided in square clusters linked by portals (the blocks on both sides of an opening between two clusters), the distances inside a cluster are cached for each portal, so only the portals graph is searched when the player moves and only a few clusters are computed again when a wall or an enemy spawner disappears.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_NAVIGATION_MANAGER_HPP
+#define HPP_NAVIGATION_MANAGER_HPP
+
+namespace NavigationManager
+{
+	/** Build the clusters and their portals for the level that has just been loaded.
+	 * @param levelWidthBlocks The level width in blocks.
+	 * @param levelHeightBlocks The level height in blocks.
+	 * @note The level blocks content is read with LevelManager::getBlockContent().
+	 */
+	void loadLevel(int levelWidthBlocks, int levelHeightBlocks);
+
+	/** Tell that a block became an obstacle or stopped being an obstacle (for instance when an enemy spawner is destroyed). The clusters touching the block will be computed again on next updatePlayerDistances() call.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 */
+	void setBlockModified(int x, int y);
+
+	/** Compute the distance from each portal to the player. This is done only when the player entered another block or when some clusters have been modified.
+	 * @param playerCenterX The player center X coordinate in pixels.
+	 * @param playerCenterY The player center Y coordinate in pixels.
+	 * @note Must be called before the enemies decide their action, the distances must not be modified while they are read.
+	 */
+	void updatePlayerDistances(int playerCenterX, int playerCenterY);
+
+	/** Get how many blocks separate a block from the player block when walking around walls and enemy spawners. The path goes through the portals of the clusters, so it can be a bit longer than the shortest one, but following the decreasing distances always leads to the player.
+	 * @param x X coordinate in pixels.
+	 * @param y Y coordinate in pixels.
+	 * @return The amount of blocks to cross to reach the player block (0 for the player block itself),
+	 * @return -1 if the block is an obstacle, can't reach the player or is outside of the level.
+	 */
+	int getPlayerDistance(int x, int y);
+
+	/** Put the player on random walkable blocks and compare the distances with an exact breadth-first search of the whole level. A block must be reachable only if the search reaches it, its distance must not be shorter than the exact one and it must have a neighbor closer to the player (so following the decreasing distances never gets stuck). This is slow, it is only used to check the navigation code.
+	 * @param checksCount How many player blocks to try.
+	 * @return How many wrong blocks have been found (they are logged), 0 if all distances are right.
+	 * @note The player distances must be computed again with updatePlayerDistances() before being used by the game.
+	 */
+	int checkPlayerDistances(int checksCount);
+}
+
+#endif
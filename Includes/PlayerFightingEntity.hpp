@@ -47,6 +47,7 @@ class PlayerFightingEntity: public FightingEntity
 		inline void setAmmunitionAmount(int ammunitionCount)
 		{
 			_ammunitionAmount = ammunitionCount;
+			_updateMortarHudState();
 		}
 		
 		/** Add ammunition to the player owned ones.
@@ -55,6 +56,7 @@ class PlayerFightingEntity: public FightingEntity
 		inline void addAmmunition(int amount)
 		{
 			_ammunitionAmount += amount;
+			_updateMortarHudState();
 		}
 		
 		/** Display the player at the screen center. */
@@ -87,23 +89,41 @@ class PlayerFightingEntity: public FightingEntity
 		/** How many ammunition the player owns. */
 		int _ammunitionAmount; // Only player has limited ammunition, because what could do a munitions-less enemy ?
 		
-		/** When was the last shot fired (in milliseconds). This is part of the fire rate mechanism. */
-		unsigned int _secondaryFireLastShotTime;
 		/** How many milliseconds to wait between two shots. */
 		unsigned int _secondaryFireTimeBetweenShots;
 		/** Tell whether the time between two shoots has elapsed. */
 		bool _isSecondaryShootReloadingTimeElapsed = true; // Allow the player to immediately shoot on spawn
+		/** The timer telling when the mortar is reloaded. */
+		int _secondaryFireReloadingTimerId;
 		
-		/** How many time remaining before the bonus becomes inactive (in milliseconds). */
-		int _bonusRemainingTime = 0;
+		/** When the currently active bonus becomes inactive (in simulation milliseconds). */
+		unsigned int _bonusEndingTime = 0;
 		/** The currently active bonus. */
 		Bonus _currentActiveBonus = BONUS_NONE;
+		/** The timer telling when the displayed bonus remaining time must be updated and when the bonus ends. */
+		int _bonusTimerId;
 		
 		/** Offset to add to entity coordinates to fire the bullet in the entity facing direction. */
 		SDL_Point _secondaryFireStartingPositionOffsets[DIRECTIONS_COUNT]; // Offsets are in the same order than Direction enum
 		
 		/** Offset to add to entity coordinates to put the shoot firing effect in front of the entity cannon. */
 		SDL_Point _secondaryFireFiringEffectStartingPositionOffsets[DIRECTIONS_COUNT]; // Offsets are in the same order than Direction enum
+		
+		/** Display the mortar state matching the ammunition amount and the reloading state. Call it each time one of them changes. */
+		void _updateMortarHudState();
+		
+		/** Display the bonus remaining time and schedule the next display update, or disable the bonus if its time is over. */
+		void _updateBonus();
+		
+		/** Called when the mortar reloading time has elapsed.
+		 * @param pointerParameter The player.
+		 */
+		static void _secondaryFireReloadingTimerCallback(void *pointerParameter);
+		
+		/** Called when the displayed bonus remaining time changes.
+		 * @param pointerParameter The player.
+		 */
+		static void _bonusTimerCallback(void *pointerParameter);
 };
 
 /** The unique player, which must be accessible to any other module. */
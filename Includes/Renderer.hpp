@@ -1,5 +1,5 @@
 /** @file Renderer.hpp
- * The game window renderer.
+ * The game window renderer. The game records each frame to draw into a snapshot, the snapshot is then drawn by a dedicated render thread while the game computes the next frame.
  * @author Adrien RICCIARDI
  */
 #ifndef HPP_RENDERER_HPP
@@ -23,6 +23,14 @@ namespace Renderer
 		TEXT_COLOR_IDS_COUNT
 	} TextColorId;
 
+	/** All ways to synchronize the displayed frames with the display refresh. */
+	typedef enum
+	{
+		VSYNC_MODE_ON, //!< Wait for the display refresh to show a frame, so frames never tear.
+		VSYNC_MODE_OFF, //!< Show a frame as soon as it is drawn, frames can tear.
+		VSYNC_MODE_ADAPTIVE //!< Wait for the display refresh, except for late frames which are immediately shown. This needs an OpenGL rendering driver, VSync is enabled otherwise.
+	} VSyncMode;
+
 	/** All available font sizes. */
 	typedef enum
 	{
@@ -31,8 +39,17 @@ namespace Renderer
 		FONT_SIZE_IDS_COUNT
 	} FontSizeId;
 
-	/** The renderer used to render to the game window. */
-	extern SDL_Renderer *pointerRenderer;
+	/** All drawing layers, from the bottom one to the top one. The frame is drawn layer by layer whatever order the drawings were recorded in. Inside a layer, the drawings are grouped by texture, so the drawings of a layer must not overlap unless they come from the same texture. */
+	typedef enum
+	{
+		LAYER_ID_SCENE, //!< The level blocks and the objects lying on them, or the menu background.
+		LAYER_ID_ENTITIES, //!< The enemy spawners, the enemies and the bullets.
+		LAYER_ID_PLAYER, //!< The player, always visible on top of the other entities.
+		LAYER_ID_EFFECTS, //!< The special effects, which can cover all entities.
+		LAYER_ID_OVERLAY, //!< The full screen overlays.
+		LAYER_ID_INTERFACE, //!< The head-up display, the messages and the menu items.
+		LAYER_IDS_COUNT
+	} LayerId;
 
 	/** Contains the visible display (it can be though as the camera) leftmost coordinate. */
 	extern int displayX;
@@ -44,29 +61,73 @@ namespace Renderer
 	/** The display height in pixels. */
 	extern int displayHeight;
 
+	/** How far the displayed frame is between the previous game tick and the last one, in range [0; 1]. Moving entities are displayed at a position interpolated with this factor, so the display can be smoother than the game update rate. Set it to 1 to display the last tick state. */
+	extern float interpolationFactor;
+
+	/** Tell whether the game is only simulated, without any window nor renderer. */
+	extern bool isHeadlessModeEnabled;
+
 	/** Initialize the SDL2 library and create a window with a renderer.
 	* @param isFullScreenEnabled Set to 1 to start the game in full screen, set to 0 to start it in windowed mode.
+	* @param isHeadlessModeRequested Set to 1 to create neither window nor renderer, all rendering functions will then do nothing (the display has the windowed mode size).
+	* @param vsyncMode How to synchronize the frames with the display refresh.
+	* @param framesPerSecondLimit The maximum amount of frames to display per second. Set to 0 to display frames as fast as the renderer can present them (at the display refresh rate when VSync is enabled).
+	* @param renderScalePercentage The resolution the game world (all layers below LAYER_ID_INTERFACE) is drawn at, in percentage of the display resolution. The world is then stretched over the display, the interface is always drawn at the display resolution. Set to 0 to lower the resolution when frames miss the display refresh and raise it again when they are in time.
 	* @return 0 if all went successful,
 	* @return -1 if an error occurred.
 	*/
-	int initialize(bool isFullScreenEnabled);
+	int initialize(bool isFullScreenEnabled, bool isHeadlessModeRequested, VSyncMode vsyncMode, int framesPerSecondLimit, int renderScalePercentage);
 
 	/** Free all allocated resources.
 	* @note This function must be called after all SDL resources have been freed.
 	*/
 	void uninitialize();
 
-	/** This function must be called at the really beginning of a frame rendering. */
+	/** This function must be called at the really beginning of a frame rendering, before reading the player inputs. It waits until the render thread can take a new frame and until the frame rate limit allows a new frame, then it starts recording a new frame snapshot. Waiting here rather than after the frame is recorded makes the inputs as recent as possible when the frame is displayed. */
 	void beginFrame();
 
-	/** End the rendering step by displaying the final picture on the screen. */
+	/** Select the layer the following drawings belong to. Each frame starts with LAYER_ID_SCENE selected.
+	* @param layerId The layer to draw to.
+	*/
+	void setLayer(LayerId layerId);
+
+	/** End the rendering step by handing the recorded frame snapshot to the render thread, which displays it on the screen. */
 	void endFrame();
 
+	/** Create a texture from a surface (the texture is created by the render thread, the calling thread waits for it).
+	* @param pointerSurface The surface to convert. It is not freed.
+	* @return The created texture,
+	* @return NULL if an error occurred (the error is logged).
+	*/
+	SDL_Texture *createTextureFromSurface(SDL_Surface *pointerSurface);
+
+	/** Create a transparent texture that can be drawn to with beginTextureDrawing(), so a part of the display that seldom changes can be drawn once and displayed as a single texture.
+	* @param width The texture width in pixels.
+	* @param height The texture height in pixels.
+	* @return The created texture, which must be freed with destroyTexture(),
+	* @return NULL in headless mode, if the renderer can't draw to textures or if an error occurred (the error is logged).
+	*/
+	SDL_Texture *createTargetTexture(int width, int height);
+
+	/** Record the following drawings to a texture instead of the display, until endTextureDrawing() is called. The texture content is replaced by these drawings before the frame is drawn, the drawing coordinates are relative to the texture top left corner.
+	* @param pointerTargetTexture A texture created with createTargetTexture().
+	*/
+	void beginTextureDrawing(SDL_Texture *pointerTargetTexture);
+
+	/** Record the following drawings to the display again. */
+	void endTextureDrawing();
+
+	/** Destroy a texture when the frames that may still display it have been drawn.
+	* @param pointerTexture The texture to destroy, nothing is done if it is NULL.
+	*/
+	void destroyTexture(SDL_Texture *pointerTexture);
+
 	/** Render the provided text on a texture.
 	* @param pointerStringText The string to render.
 	* @param colorId The text color.
 	* @param fontSizeId The font size.
-	* @return A texture containing the rendered text. Caller must free this texture.
+	* @return A texture containing the rendered text. Caller must free this texture with destroyTexture(),
+	* @return NULL in headless mode.
 	* @warning This function halts the game if something goes wrong.
 	*/
 	SDL_Texture *renderTextToTexture(const char *pointerStringText, TextColorId colorId, FontSizeId fontSizeId);
@@ -83,6 +144,30 @@ namespace Renderer
 	* @param y Vertical coordinate of the texture top left corner. If set to -1 the texture will be also centered vertically.
 	*/
 	void renderCenteredTexture(SDL_Texture *pointerTexture, int y = -1);
+
+	/** Display a part of the provided texture.
+	* @param pointerTexture The texture to display.
+	* @param pointerSourceRectangle The texture part to display, set to NULL to display the whole texture.
+	* @param pointerDestinationRectangle The display area to draw to, set to NULL to stretch the texture over the whole display.
+	*/
+	void renderTextureArea(SDL_Texture *pointerTexture, const SDL_Rect *pointerSourceRectangle, const SDL_Rect *pointerDestinationRectangle);
+
+	/** Display a rectangle outline.
+	* @param pointerRectangle The rectangle display coordinates.
+	* @param red The color red component.
+	* @param green The color green component.
+	* @param blue The color blue component.
+	*/
+	void renderRectangle(const SDL_Rect *pointerRectangle, Uint8 red, Uint8 green, Uint8 blue);
+
+	/** Display a text. The text is drawn with the characters rendered once to the glyph atlas when the renderer was initialized, so frequently changing values can be displayed without rendering nor creating any texture. Only printable ASCII characters can be displayed, the other ones are replaced by a question mark.
+	* @param pointerStringText The string to display.
+	* @param colorId The text color.
+	* @param fontSizeId The font size.
+	* @param x Horizontal coordinate of the text top left corner. If set to -1 the text is centered horizontally.
+	* @param y Vertical coordinate of the text top left corner.
+	*/
+	void renderText(const char *pointerStringText, TextColorId colorId, FontSizeId fontSizeId, int x, int y);
 }
 
 #endif
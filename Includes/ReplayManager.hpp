@@ -0,0 +1,74 @@
+/** @file ReplayManager.hpp
+ * Record the player inputs of each game tick to a file, and feed them back later to reproduce exactly the same game.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_REPLAY_MANAGER_HPP
+#define HPP_REPLAY_MANAGER_HPP
+
+namespace ReplayManager
+{
+	/** Everything needed to start a game the same way it was recorded. */
+	typedef struct
+	{
+		unsigned int randomSeed; //!< The value the pseudo-random numbers generator was seeded with.
+		int startingLevelNumber; //!< The first played level.
+		int playerMaximumLifePointsAmount; //!< The player maximum life points when the game started (the player is healthy on game start).
+		int playerAmmunitionAmount; //!< The player ammunition when the game started.
+	} GameStartingState;
+
+	/** Create the record file and store the game starting state in it.
+	* @param pointerStringFileName The record file to create.
+	* @param pointerGameStartingState The state the recorded game starts with.
+	* @return 0 if the recording started successfully,
+	* @return -1 if an error occurred.
+	*/
+	int startRecording(const char *pointerStringFileName, GameStartingState *pointerGameStartingState);
+
+	/** Tell that the current level has been restarted, this will be recorded with the next tick. */
+	void recordLevelRestart();
+
+	/** Record the player inputs and the simulation time step of the current tick.
+	* @note Must be called once per game update, after the simulation clock has been updated.
+	*/
+	void recordTick();
+
+	/** Terminate and close the record file.
+	* @param gameStateChecksum A value summarizing the game state when the recording ended, a replay ending with another value has diverged.
+	*/
+	void stopRecording(unsigned int gameStateChecksum);
+
+	/** Open a record file and get the game starting state from it. The simulation clock will be driven by the recorded time steps.
+	* @param pointerStringFileName The record file to play.
+	* @param pointerGameStartingState On output, contain the state the recorded game started with.
+	* @return 0 if the replay started successfully,
+	* @return -1 if an error occurred.
+	*/
+	int startReplay(const char *pointerStringFileName, GameStartingState *pointerGameStartingState);
+
+	/** Apply the recorded player inputs and simulation time step of the next tick.
+	* @param pointerIsLevelRestarted On output, tell whether the level must be restarted before simulating this tick.
+	* @return 0 if the tick has been applied,
+	* @return 1 if the replay has ended.
+	* @note Must be called once per game update, before the simulation clock is updated.
+	*/
+	int replayTick(bool *pointerIsLevelRestarted);
+
+	/** Close the record file.
+	* @return The game state checksum stored at the end of the record file (it is valid only if the replay has ended).
+	*/
+	unsigned int stopReplay();
+
+	/** Tell whether a game is currently recorded.
+	* @return true if the game is recorded,
+	* @return false if no recording is in progress.
+	*/
+	bool isRecording();
+
+	/** Tell whether a record file is currently replayed.
+	* @return true if the game is replayed,
+	* @return false if no replay is in progress.
+	*/
+	bool isReplaying();
+}
+
+#endif
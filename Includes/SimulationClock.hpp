@@ -0,0 +1,65 @@
+/** @file SimulationClock.hpp
+ * The single time reference read by all gameplay subsystems. It advances only on game updates, so it stops when the game is paused and it can run slower or faster than real time.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_SIMULATION_CLOCK_HPP
+#define HPP_SIMULATION_CLOCK_HPP
+
+namespace SimulationClock
+{
+	/** Reset the simulation time to zero and start measuring real time.
+	* @return 0 if all went successful,
+	* @return -1 if an error occurred.
+	*/
+	int initialize();
+
+	/** Advance the simulation time by the real time elapsed since the previous call, or by the fixed time step if one is set. Nothing is advanced while the clock is paused.
+	* @note Must be called once at the beginning of each game update step.
+	*/
+	void update();
+
+	/** Measure the real time elapsed since the previous call (multiplied by the time scale) and tell how many ticks of CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS it contains. The remaining time is kept for the next call.
+	* @return How many ticks must be simulated before displaying the next frame (at most CONFIGURATION_GAMEPLAY_MAXIMUM_TICKS_PER_FRAME). Always 0 while the clock is paused.
+	* @note Must be called once per displayed frame.
+	*/
+	int getElapsedTicksCount();
+
+	/** Tell how far the real time is between the last simulated tick and the next one, so the displayed positions can be interpolated.
+	* @return A value in range [0; 1[, 0 meaning the real time is exactly on the last simulated tick.
+	*/
+	float getInterpolationFactor();
+
+	/** Stop the simulation time until resume() is called. */
+	void pause();
+
+	/** Restart the simulation time after a pause. The real time spent in pause is discarded. */
+	void resume();
+
+	/** Tell whether the clock is paused.
+	* @return true if the clock is paused,
+	* @return false if the clock is running.
+	*/
+	bool isPaused();
+
+	/** Set how fast the simulation time flows compared to real time. Only the amount of ticks to simulate is scaled, so each tick still advances the simulation time by the same fixed step and the gameplay timings stay consistent with the entities moves.
+	* @param scale 1 for real time, less than 1 to slow down the game, more than 1 to speed it up, 0 to stop it like a pause.
+	*/
+	void setScale(float scale);
+
+	/** Make each update advance the simulation time by a constant amount instead of the measured real time. This is needed to run the simulation faster than real time while keeping the gameplay timings consistent.
+	* @param milliseconds How much time to add on each update. Set to -1 to go back to real time measurement.
+	*/
+	void setFixedTimeStep(int milliseconds);
+
+	/** Get the simulation time.
+	* @return The simulation time in milliseconds. Use unsigned subtraction to compute durations, like with SDL_GetTicks().
+	*/
+	unsigned int getTime();
+
+	/** Get how many game update steps (ticks) have been simulated.
+	* @return The simulated ticks count.
+	*/
+	unsigned int getTicksCount();
+}
+
+#endif
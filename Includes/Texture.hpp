@@ -13,9 +13,13 @@ class Texture
 {
 	public:
 		/** Create a still texture.
-		 * @param pointerSDLTexture The SDL texture to display.
+		 * @param pointerSDLTexture The SDL texture to display (it can be NULL in headless mode). Several textures can share the same SDL texture.
+		 * @param x X coordinate of the picture top left angle in the SDL texture.
+		 * @param y Y coordinate of the picture top left angle in the SDL texture.
+		 * @param width The texture width in pixels.
+		 * @param height The texture height in pixels.
 		 */
-		Texture(SDL_Texture *pointerSDLTexture);
+		Texture(SDL_Texture *pointerSDLTexture, int x, int y, int width, int height);
 		
 		/** Free allocated resources. */
 		virtual ~Texture() {}
@@ -51,9 +55,19 @@ class Texture
 			return _pointerSDLTexture;
 		}
 
+		/** Get the area of the SDL texture containing the picture.
+		 * @return The source rectangle to give to the renderer.
+		 */
+		inline const SDL_Rect *getSourceRectangle()
+		{
+			return &_sourceRectangle;
+		}
+
 	protected:
 		/** The texture. */
 		SDL_Texture *_pointerSDLTexture;
+		/** Where the whole picture is located in the SDL texture. */
+		SDL_Rect _sourceRectangle;
 		
 		/** Texture width in pixels. */
 		int _width;
@@ -0,0 +1,46 @@
+/** @file TimerManager.hpp
+ * Call functions when a simulation time is reached. Timers are stored in a hierarchical timing wheel, so scheduling and cancelling a timer take a constant time and only the expired timers are visited on each game update.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_TIMER_MANAGER_HPP
+#define HPP_TIMER_MANAGER_HPP
+
+namespace TimerManager
+{
+	/** A function called when a timer expires.
+	* @param pointerParameter The parameter given when scheduling the timer.
+	*/
+	typedef void (*TimerFunction)(void *pointerParameter);
+
+	/** The value of a timer identifier that does not refer to any timer. */
+	const int TIMER_ID_NONE = -1;
+
+	/** Start counting time from the current simulation time.
+	* @return 0 if all went successful,
+	* @return -1 if an error occurred.
+	*/
+	int initialize();
+
+	/** Free all timers. */
+	void uninitialize();
+
+	/** Call the function of all timers whose expiration time has been reached by the simulation clock.
+	* @note Must be called right after each SimulationClock::update() call, so the expired timers are handled before anything else uses the new simulation time.
+	*/
+	void update();
+
+	/** Call a function once after some simulation time. Like time comparisons, the function is called on the first update where the simulation time is greater than or equal to the expiration time.
+	* @param delayMilliseconds How much simulation time must elapse before calling the function. A timer expiring now or in the past is called on next update.
+	* @param pointerFunction The function to call (it can schedule timers).
+	* @param pointerParameter A value forwarded to the function.
+	* @return The timer identifier, which is valid until the function is called or the timer is cancelled.
+	*/
+	int schedule(unsigned int delayMilliseconds, TimerFunction pointerFunction, void *pointerParameter);
+
+	/** Remove a timer before it expires.
+	* @param timerId The timer to remove, nothing is done if it is TIMER_ID_NONE. It must not be a timer that already expired.
+	*/
+	void cancel(int timerId);
+}
+
+#endif
@@ -0,0 +1,52 @@
+/** @file VisibilityManager.hpp
+ * Find the entities visible on the display without visiting all level entities. The level is divided in square cells, each cell keeps the list of the entities whose top left corner is inside it, so only the cells covered by the display are visited when rendering.
+ * @author Adrien RICCIARDI
+ */
+#ifndef HPP_VISIBILITY_MANAGER_HPP
+#define HPP_VISIBILITY_MANAGER_HPP
+
+// Entity.hpp includes this file to remove the destroyed entities from the cells
+class Entity;
+
+namespace VisibilityManager
+{
+	/** All kinds of entities, each kind is rendered separately so the caller decides the displaying order. */
+	typedef enum
+	{
+		ENTITY_TYPE_ENEMY_SPAWNER,
+		ENTITY_TYPE_ENEMY,
+		ENTITY_TYPE_BULLET,
+		ENTITY_TYPE_EFFECT,
+		ENTITY_TYPES_COUNT
+	} EntityType;
+
+	/** Create empty cells for the level that is being loaded.
+	 * @param levelWidthBlocks The level width in blocks.
+	 * @param levelHeightBlocks The level height in blocks.
+	 * @note The entities of the previous level must have been destroyed.
+	 */
+	void loadLevel(int levelWidthBlocks, int levelHeightBlocks);
+
+	/** Store an entity in the cell containing its top left corner. Nothing is done in headless mode.
+	 * @param pointerEntity The entity, it is automatically removed from its cell when it is destroyed.
+	 * @param entityType The entity kind.
+	 */
+	void addEntity(Entity *pointerEntity, EntityType entityType);
+
+	/** Move an entity to another cell if its top left corner left its cell. This must be called each time the entity moved.
+	 * @param pointerEntity The entity, nothing is done if it was not added.
+	 */
+	void updateEntity(Entity *pointerEntity);
+
+	/** Remove an entity from its cell.
+	 * @param pointerEntity The entity, nothing is done if it was not added.
+	 */
+	void removeEntity(Entity *pointerEntity);
+
+	/** Render the entities of a kind located in the cells covered by the display (see Renderer::displayX and Renderer::displayY).
+	 * @param entityType The kind of entities to render.
+	 */
+	void renderEntities(EntityType entityType);
+}
+
+#endif
@@ -3,15 +3,17 @@
  * @author Adrien RICCIARDI
  */
 #include <AnimatedTexture.hpp>
+#include <Configuration.hpp>
 #include <Log.hpp>
 #include <Renderer.hpp>
+#include <SimulationClock.hpp>
 
-AnimatedTexture::AnimatedTexture(SDL_Texture *pointerSDLTexture, int imagesCount, int framesPerImageCount, bool isAnimationLooping): Texture(pointerSDLTexture)
+AnimatedTexture::AnimatedTexture(Texture *pointerTexture, int imagesCount, int framesPerImageCount, bool isAnimationLooping): Texture(pointerTexture->getSDLTexture(), pointerTexture->getSourceRectangle()->x, pointerTexture->getSourceRectangle()->y, pointerTexture->getWidth(), pointerTexture->getHeight())
 {
 	_currentImageIndex = 0;
-	_framesCounter = 0;
+	_currentImageStartingTime = SimulationClock::getTime();
 	_imagesCount = imagesCount;
-	_framesPerImageCount = framesPerImageCount;
+	_imageDisplayingDuration = framesPerImageCount * CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS;
 	_isAnimationLooping = isAnimationLooping;
 	
 	// Determine a single image width
@@ -22,18 +24,20 @@ AnimatedTexture::AnimatedTexture(SDL_Texture *pointerSDLTexture, int imagesCount
 int AnimatedTexture::render(int x, int y)
 {
 	// Should the next image be displayed ?
-	_framesCounter++;
-	if (_framesCounter >= _framesPerImageCount)
+	unsigned int elapsedTime = SimulationClock::getTime() - _currentImageStartingTime;
+	if (elapsedTime >= _imageDisplayingDuration)
 	{
+		// Skip as many images as needed if the simulation time went faster than the rendering
+		int elapsedImagesCount = elapsedTime / _imageDisplayingDuration;
+		_currentImageStartingTime += elapsedImagesCount * _imageDisplayingDuration;
+		
 		// Is the animation end reached ?
-		_currentImageIndex++;
+		_currentImageIndex += elapsedImagesCount;
 		if (_currentImageIndex >= _imagesCount)
 		{
 			if (!_isAnimationLooping) return 1; // Looping mode is disabled, stop displaying if the animation end has been reached
-			else _currentImageIndex = 0;
+			else _currentImageIndex %= _imagesCount;
 		}
-		
-		_framesCounter = 0;
 	}
 	
 	// Set texture position on display
@@ -48,13 +52,22 @@ int AnimatedTexture::render(int x, int y)
 	{
 		// Determine the part of the sprite to display
 		SDL_Rect displayingRectangle;
-		displayingRectangle.x = _currentImageIndex * _width;
-		displayingRectangle.y = 0;
+		displayingRectangle.x = _sourceRectangle.x + (_currentImageIndex * _width);
+		displayingRectangle.y = _sourceRectangle.y;
 		displayingRectangle.w = _width;
 		displayingRectangle.h = _height;
 		
-		SDL_RenderCopy(Renderer::pointerRenderer, _pointerSDLTexture, &displayingRectangle, &positionRectangle);
+		Renderer::renderTextureArea(_pointerSDLTexture, &displayingRectangle, &positionRectangle);
 	}
 	
 	return 0;
 }
+
+bool AnimatedTexture::isAnimationTerminated()
+{
+	if (_isAnimationLooping) return false;
+	
+	// Count the images that should have been displayed since the last rendering
+	int elapsedImagesCount = (SimulationClock::getTime() - _currentImageStartingTime) / _imageDisplayingDuration;
+	return _currentImageIndex + elapsedImagesCount >= _imagesCount;
+}
@@ -5,10 +5,7 @@
 #include <AnimatedTextureStaticEntity.hpp>
 #include <Renderer.hpp>
 
-AnimatedTextureStaticEntity::AnimatedTextureStaticEntity(int x, int y, AnimatedTexture *pointerTexture): StaticEntity(x, y, pointerTexture)
-{
-	_isAnimationTerminated = 0;
-}
+AnimatedTextureStaticEntity::AnimatedTextureStaticEntity(int x, int y, AnimatedTexture *pointerTexture): StaticEntity(x, y, pointerTexture) {}
 
 AnimatedTextureStaticEntity::~AnimatedTextureStaticEntity()
 {
@@ -18,10 +15,11 @@ AnimatedTextureStaticEntity::~AnimatedTextureStaticEntity()
 void AnimatedTextureStaticEntity::render()
 {
 	// Display the animation current image
-	if (_pointerTexture->render(_positionRectangle.x - Renderer::displayX, _positionRectangle.y - Renderer::displayY) != 0) _isAnimationTerminated = 1;
+	_pointerTexture->render(_positionRectangle.x - Renderer::displayX, _positionRectangle.y - Renderer::displayY);
 }
 
 int AnimatedTextureStaticEntity::update()
 {
-	return _isAnimationTerminated;
+	if (static_cast<AnimatedTexture *>(_pointerTexture)->isAnimationTerminated()) return 1;
+	return 0;
 }
@@ -134,6 +134,12 @@ namespace AudioManager
 	/** Tell the thread it must exit. */
 	static volatile int _isThreadTerminated = 0;
 
+	/** Tell whether sounds and musics can be played. */
+	static bool _isAudioEnabled = false;
+
+	/** The last played music. */
+	static unsigned int _currentMusicIndex;
+
 	/** Load a sound from a wave file.
 	* @param pointerStringFileName The file to load.
 	* @return A pointer on the chunk containing the sound.
@@ -188,8 +194,15 @@ namespace AudioManager
 		return 0;
 	}
 
-	int initialize()
+	int initialize(bool isAudioEnabled)
 	{
+		// Nothing to load if no sound will be played
+		if (!isAudioEnabled)
+		{
+			LOG_INFORMATION("Audio is disabled.");
+			return 0;
+		}
+		
 		// Open audio mixer
 		if (Mix_OpenAudio(CONFIGURATION_AUDIO_SAMPLING_FREQUENCY, MIX_DEFAULT_FORMAT, 2, 1024) != 0) // Chunk size has been randomly chosen due to extremely explicit documentation...
 		{
@@ -223,6 +236,9 @@ namespace AudioManager
 		}
 		LOG_DEBUG("Loaded %d music files.", i);
 		
+		// Do not always start with the same music
+		_currentMusicIndex = SDL_GetTicks() % MUSICS_COUNT;
+		
 		// Call a callback when playing a music has finished
 		Mix_HookMusicFinished(_wakeUpMusicThread);
 		
@@ -250,11 +266,14 @@ namespace AudioManager
 			return -1;
 		}
 		
+		_isAudioEnabled = true;
 		return 0;
 	}
 
 	void uninitialize()
 	{
+		if (!_isAudioEnabled) return;
+		
 		// Tell the thread to exit
 		_isThreadTerminated = 1;
 		_wakeUpMusicThread();
@@ -281,7 +300,7 @@ namespace AudioManager
 		assert(id < SOUND_IDS_COUNT);
 		
 		// Do nothing if no sound should be played
-		if (id == SOUND_ID_NO_SOUND) return;
+		if ((id == SOUND_ID_NO_SOUND) || !_isAudioEnabled) return;
 		
 		// Try to play the sound on the first available channel
 		int channel = Mix_PlayChannel(-1, _pointerSounds[id], 0);
@@ -297,22 +316,28 @@ namespace AudioManager
 
 	void playMusic()
 	{
-		// Select a random music
-		int musicIndex = rand() % MUSICS_COUNT;
+		if (!_isAudioEnabled) return;
+		
+		// Select the next music (the pseudo-random numbers generator can't be used because this function is also called by the music thread, so the game random numbers would depend on the music timing)
+		_currentMusicIndex = (_currentMusicIndex + 1) % MUSICS_COUNT;
 		
 		// Try to play it
-		if (Mix_PlayMusic(_musics[musicIndex].pointerMusicHandle, 1) != 0) LOG_ERROR("Failed to play music %s (%s).", _musics[musicIndex].pointerStringFileName, Mix_GetError());
-		else LOG_DEBUG("Playing music '%s'.", _musics[musicIndex].pointerStringFileName);
+		if (Mix_PlayMusic(_musics[_currentMusicIndex].pointerMusicHandle, 1) != 0) LOG_ERROR("Failed to play music %s (%s).", _musics[_currentMusicIndex].pointerStringFileName, Mix_GetError());
+		else LOG_DEBUG("Playing music '%s'.", _musics[_currentMusicIndex].pointerStringFileName);
 	}
 
 	void pauseMusic(bool isMusicPaused)
 	{
+		if (!_isAudioEnabled) return;
+		
 		if (isMusicPaused) Mix_PauseMusic();
 		else Mix_ResumeMusic();
 	}
 
 	void stopAllSounds()
 	{
+		if (!_isAudioEnabled) return;
+		
 		Mix_HaltChannel(-1);
 	}
 	
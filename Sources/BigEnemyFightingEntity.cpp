@@ -4,14 +4,14 @@
  */
 #include <BigEnemyFightingEntity.hpp>
 #include <EffectManager.hpp>
-#include <SDL2/SDL.h>
+#include <SimulationClock.hpp>
 #include <TextureManager.hpp>
 
 BigEnemyFightingEntity::BigEnemyFightingEntity(int x, int y): EnemyFightingEntity(x, y, TextureManager::TEXTURE_ID_BIG_ENEMY_FACING_UP, 1, 10, 10000, TextureManager::TEXTURE_ID_BIG_ENEMY_BULLET_FACING_UP, EffectManager::EFFECT_ID_BIG_ENEMY_MUZZLE_FLASH_FACING_UP, EffectManager::EFFECT_ID_BIG_ENEMY_EXPLOSION)
 {
 	// Make big enemies wait 3 seconds before shooting (to avoid them shooting instantly when spawned)
-	unsigned int currentTime = SDL_GetTicks();
-	if (currentTime > 7000) _lastShotTime = currentTime - 7000;
+	_lastShotTime = SimulationClock::getTime() - 7000;
+	_updateReloadingTimer();
 }
 
 BigEnemyFightingEntity::~BigEnemyFightingEntity() {}
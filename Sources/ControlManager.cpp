@@ -85,6 +85,14 @@ namespace ControlManager
 		return _isKeyPressed[keyId];
 	}
 
+	void setKeyPressed(KeyId keyId, bool isPressed)
+	{
+		// Silently ignore a non-existing key
+		if (keyId >= KEY_IDS_COUNT) return;
+		
+		_isKeyPressed[keyId] = isPressed;
+	}
+
 	void handleKeyboardEvent(SDL_Event *pointerEvent)
 	{
 		// Handle key press
@@ -266,4 +274,9 @@ namespace ControlManager
 	{
 		return _isLastPressedDirectionKeyOnVerticalAxis;
 	}
+
+	void setLastPressedDirectionKeyOnVerticalAxis(bool isVerticalAxis)
+	{
+		_isLastPressedDirectionKeyOnVerticalAxis = isVerticalAxis;
+	}
 }
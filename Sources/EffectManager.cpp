@@ -8,7 +8,9 @@
 #include <EffectManager.hpp>
 #include <list>
 #include <Log.hpp>
+#include <Renderer.hpp>
 #include <TextureManager.hpp>
+#include <VisibilityManager.hpp>
 
 namespace EffectManager
 {
@@ -17,7 +19,7 @@ namespace EffectManager
 	{
 		TextureManager::TextureId textureId; //!< The animation texture ID.
 		AudioManager::SoundId soundId; //!< The sound to play.
-		int availableSounds; //!< How many available sound (their IDs must be contiguous to soundId), a sound will be randomly picked up from the available ones.
+		int availableSounds; //!< How many available sound (their IDs must be contiguous to soundId), a different sound will be picked up from the available ones each time.
 	} Effect;
 
 	/** Cache all effect parameters. */
@@ -208,6 +210,9 @@ namespace EffectManager
 	/** All animated textures. */
 	static std::list<AnimatedTextureStaticEntity *> _animatedTexturesList;
 
+	/** Incremented each time an effect with several sounds is generated, to select the sound to play. */
+	static unsigned int _soundSelectionCounter = 0;
+
 	int getEffectTextureWidth(EffectId effectId)
 	{
 		// Make sure the requested effect is existing
@@ -229,18 +234,23 @@ namespace EffectManager
 		// Make sure the requested effect is existing
 		assert(effectId < EFFECT_IDS_COUNT);
 		
+		// Effects are only visual and audio feedback, they do not need to be simulated when nothing is displayed
+		if (Renderer::isHeadlessModeEnabled) return;
+		
 		// Cache effect access
 		Effect *pointerEffect = &effects[effectId];
 		
 		// Generate the graphic effect
-		_animatedTexturesList.push_front(new AnimatedTextureStaticEntity(x, y, TextureManager::createAnimatedTextureFromId(pointerEffect->textureId, false)));
+		AnimatedTextureStaticEntity *pointerAnimatedTextureStaticEntity = new AnimatedTextureStaticEntity(x, y, TextureManager::createAnimatedTextureFromId(pointerEffect->textureId, false));
+		_animatedTexturesList.push_front(pointerAnimatedTextureStaticEntity);
+		VisibilityManager::addEntity(pointerAnimatedTextureStaticEntity, VisibilityManager::ENTITY_TYPE_EFFECT);
 		
-		// Randomly select a sound if more are available
+		// Cycle through the sounds if more are available (do not use the pseudo-random numbers generator, it would be consumed differently when nothing is displayed and a replayed game would diverge)
 		AudioManager::SoundId soundId;
 		if (pointerEffect->availableSounds > 1)
 		{
-			int randomIndex = rand() % pointerEffect->availableSounds;
-			soundId = static_cast<AudioManager::SoundId>(pointerEffect->soundId + randomIndex);
+			_soundSelectionCounter++;
+			soundId = static_cast<AudioManager::SoundId>(pointerEffect->soundId + (_soundSelectionCounter % pointerEffect->availableSounds));
 		}
 		else soundId = pointerEffect->soundId; // There is only one sound, select it
 		
@@ -276,7 +286,6 @@ namespace EffectManager
 
 	void render()
 	{
-		std::list<AnimatedTextureStaticEntity *>::iterator animatedTexturesListIterator;
-		for (animatedTexturesListIterator = _animatedTexturesList.begin(); animatedTexturesListIterator != _animatedTexturesList.end(); ++animatedTexturesListIterator) (*animatedTexturesListIterator)->render();
+		VisibilityManager::renderEntities(VisibilityManager::ENTITY_TYPE_EFFECT);
 	}
 }
@@ -6,10 +6,10 @@
 #include <AudioManager.hpp>
 #include <BulletMovingEntity.hpp>
 #include <Configuration.hpp>
-#include <cstdlib>
 #include <EnemyFightingEntity.hpp>
 #include <LevelManager.hpp>
 #include <Log.hpp>
+#include <NavigationManager.hpp>
 #include <PlayerFightingEntity.hpp>
 #include <Renderer.hpp>
 #include <TextureManager.hpp>
@@ -54,8 +54,13 @@ EnemyFightingEntity::EnemyFightingEntity(int x, int y, TextureManager::TextureId
 	_shootingRectangles[DIRECTION_RIGHT].w = (Renderer::displayWidth / 2) - (_positionRectangles[DIRECTION_UP].h / 2);
 	_shootingRectangles[DIRECTION_RIGHT].h = bulletWidth;
 	
-	// Set block under enemy center as containing an enemy
-	_setBlockEnemyContent(1);
+	// Count the enemy on the block under its center
+	_addToBlock();
+	
+	// Do nothing until the first decision
+	_decidedAction = ACTION_IDLE;
+	_replacementDirectionTicksCount = 0;
+	_decidedFacingDirection = _facingDirection;
 }
 
 EnemyFightingEntity::~EnemyFightingEntity() {}
@@ -82,11 +87,11 @@ void EnemyFightingEntity::setY(int y)
 
 int EnemyFightingEntity::moveToUp()
 {
-	// Remove enemy presence from current block
-	_setBlockEnemyContent(0);
+	// Remove enemy presence from current block, so the enemy does not collide with itself
+	_removeFromBlock();
 	int movedPixelsAmount = MovingEntity::moveToUp();
 	// Set enemy presence in new block
-	_setBlockEnemyContent(1);
+	_addToBlock();
 	
 	// Adjust rectangles coordinates to take this move into account
 	_spottingRectangle.y -= movedPixelsAmount;
@@ -97,11 +102,11 @@ int EnemyFightingEntity::moveToUp()
 
 int EnemyFightingEntity::moveToDown()
 {
-	// Remove enemy presence from current block
-	_setBlockEnemyContent(0);
+	// Remove enemy presence from current block, so the enemy does not collide with itself
+	_removeFromBlock();
 	int movedPixelsAmount = MovingEntity::moveToDown();
 	// Set enemy presence in new block
-	_setBlockEnemyContent(1);
+	_addToBlock();
 	
 	// Adjust rectangles coordinates to take this move into account
 	_spottingRectangle.y += movedPixelsAmount;
@@ -112,11 +117,11 @@ int EnemyFightingEntity::moveToDown()
 
 int EnemyFightingEntity::moveToLeft()
 {
-	// Remove enemy presence from current block
-	_setBlockEnemyContent(0);
+	// Remove enemy presence from current block, so the enemy does not collide with itself
+	_removeFromBlock();
 	int movedPixelsAmount = MovingEntity::moveToLeft();
 	// Set enemy presence in new block
-	_setBlockEnemyContent(1);
+	_addToBlock();
 	
 	// Adjust rectangles coordinates to take this move into account
 	_spottingRectangle.x -= movedPixelsAmount;
@@ -127,11 +132,11 @@ int EnemyFightingEntity::moveToLeft()
 
 int EnemyFightingEntity::moveToRight()
 {
-	// Remove enemy presence from current block
-	_setBlockEnemyContent(0);
+	// Remove enemy presence from current block, so the enemy does not collide with itself
+	_removeFromBlock();
 	int movedPixelsAmount = MovingEntity::moveToRight();
 	// Set enemy presence in new block
-	_setBlockEnemyContent(1);
+	_addToBlock();
 	
 	// Adjust rectangles coordinates to take this move into account
 	_spottingRectangle.x += movedPixelsAmount;
@@ -140,13 +145,43 @@ int EnemyFightingEntity::moveToRight()
 	return movedPixelsAmount;
 }
 
+void EnemyFightingEntity::decide()
+{
+	// Keep the current direction by default
+	_decidedFacingDirection = _facingDirection;
+	
+	// Nothing to do if the player is not spotted (update() handles the enemy death by itself)
+	if ((_lifePointsAmount == 0) || !SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_spottingRectangle))
+	{
+		_decidedAction = ACTION_IDLE;
+		return;
+	}
+	
+	// Shoot if the player is at sight
+	if (_isShootPossible(&_decidedFacingDirection))
+	{
+		_decidedAction = ACTION_SHOOT;
+		return;
+	}
+	
+	// If the enemy can't shoot, it must move to come close enough to the player
+	if (_getPlayerDirection(_decidedFacingDirection, &_decidedMovingDirection)) _decidedAction = ACTION_MOVE; // The best direction is the one to reach the player
+	else _decidedAction = ACTION_WAIT;
+}
+
+void EnemyFightingEntity::repeatDecision()
+{
+	// Go on moving toward the player, but do not shoot without checking the line of sight
+	if (_decidedAction == ACTION_SHOOT) _decidedAction = ACTION_WAIT;
+}
+
 int EnemyFightingEntity::update()
 {
 	// The entity is dead, remove it
 	if (_lifePointsAmount == 0)
 	{
 		// Remove enemy presence from the block
-		_setBlockEnemyContent(0);
+		_removeFromBlock();
 		
 		// Display explosion
 		int soundEmitterAngle = 0, soundEmitterDistance = 0, entityX = this->getX(), entityY = this->getY();
@@ -157,39 +192,36 @@ int EnemyFightingEntity::update()
 	}
 	
 	// Nothing to do if the player is not spotted
-	if (!SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_spottingRectangle)) return 0;
+	if (_decidedAction == ACTION_IDLE) return 0;
+	
+	// Face the player if it entered a shooting area
+	_facingDirection = _decidedFacingDirection;
 	
 	// Shoot if the player is at sight
-	if (_isShootPossible()) return 2;
+	if (_decidedAction == ACTION_SHOOT) return 2;
 	
-	// If the enemy can't shoot, it must move to come close enough to the player
-	Direction playerDirection;
-	if (!_getPlayerDirection(&playerDirection)) // The best direction is the one to reach the player
+	// The enemy can't shoot, but it can't come closer to the player either
+	if (_decidedAction == ACTION_WAIT)
 	{
 		LOG_DEBUG("Enemy can't shoot but can't move either.");
 		return 0;
 	}
 	
-	// Try to move in the best direction
-	int movedPixelsAmount = move(playerDirection);
-	if (movedPixelsAmount > 0) _isReplacementDirectionChosen = 0; // Enemy can move in its preferred direction, no need to use a replacement one
-	else
+	// Keep stepping aside until the enemy had the time to leave the way of the enemy it avoids, trying the player direction at each tick would mostly fail
+	if (_replacementDirectionTicksCount > 0)
 	{
-		// Choose a replacement direction different from the best one (which is obstructed by a wall)
-		if (!_isReplacementDirectionChosen)
-		{
-			do
-			{
-				_replacementDirection = (Direction) (rand() % DIRECTIONS_COUNT);
-			} while (_replacementDirection == playerDirection);
-		}
-		
-		// Try to move in the chosen direction
-		movedPixelsAmount = move(_replacementDirection);
-		if (movedPixelsAmount == 0) _isReplacementDirectionChosen = 0; // There is a wall here too... More luck next tick ! TODO : for loop to make sure all enemies move at each tick ?
-		else _isReplacementDirectionChosen = 1;
+		_replacementDirectionTicksCount--;
+		if (move(_replacementDirection) > 0) return 0;
+		_replacementDirectionTicksCount = 0; // The way is obstructed, look at the player direction again
 	}
 	
+	// Try to move in the best direction (the paths go around the walls, but another enemy can be in the way). Enemies are updated one after the other, so each enemy sees the blocks taken by the enemies updated before it
+	if (move(_decidedMovingDirection) > 0) return 0;
+	
+	// Step aside to let the enemy in the way move
+	if (!_getAvoidanceDirection(_decidedMovingDirection, &_replacementDirection)) return 0; // All neighbor blocks are taken, wait for the other enemies to move
+	if (move(_replacementDirection) > 0) _replacementDirectionTicksCount = CONFIGURATION_LEVEL_BLOCK_SIZE / _movingPixelsAmount; // Go on until a whole block has been crossed
+	
 	return 0;
 }
 
@@ -201,93 +233,87 @@ void EnemyFightingEntity::render()
 	#if CONFIGURATION_LOG_LEVEL == 3
 	{
 		// Spotting rectangle
-		SDL_SetRenderDrawColor(Renderer::pointerRenderer, 0, 255, 0, 255);
-		
 		SDL_Rect renderingRectangle;
 		renderingRectangle.x = _spottingRectangle.x - Renderer::displayX;
 		renderingRectangle.y = _spottingRectangle.y - Renderer::displayY;
 		renderingRectangle.w = _spottingRectangle.w;
 		renderingRectangle.h = _spottingRectangle.h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
+		Renderer::renderRectangle(&renderingRectangle, 0, 255, 0);
 		
 		// Shooting rectangles
-		SDL_SetRenderDrawColor(Renderer::pointerRenderer, 255, 0, 0, 255);
-		
 		renderingRectangle.x = _shootingRectangles[DIRECTION_UP].x - Renderer::displayX;
 		renderingRectangle.y = _shootingRectangles[DIRECTION_UP].y - Renderer::displayY;
 		renderingRectangle.w = _shootingRectangles[DIRECTION_UP].w;
 		renderingRectangle.h = _shootingRectangles[DIRECTION_UP].h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
+		Renderer::renderRectangle(&renderingRectangle, 255, 0, 0);
 		
 		renderingRectangle.x = _shootingRectangles[DIRECTION_DOWN].x - Renderer::displayX;
 		renderingRectangle.y = _shootingRectangles[DIRECTION_DOWN].y - Renderer::displayY;
 		renderingRectangle.w = _shootingRectangles[DIRECTION_DOWN].w;
 		renderingRectangle.h = _shootingRectangles[DIRECTION_DOWN].h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
+		Renderer::renderRectangle(&renderingRectangle, 255, 0, 0);
 		
 		renderingRectangle.x = _shootingRectangles[DIRECTION_LEFT].x - Renderer::displayX;
 		renderingRectangle.y = _shootingRectangles[DIRECTION_LEFT].y - Renderer::displayY;
 		renderingRectangle.w = _shootingRectangles[DIRECTION_LEFT].w;
 		renderingRectangle.h = _shootingRectangles[DIRECTION_LEFT].h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
+		Renderer::renderRectangle(&renderingRectangle, 255, 0, 0);
 		
 		renderingRectangle.x = _shootingRectangles[DIRECTION_RIGHT].x - Renderer::displayX;
 		renderingRectangle.y = _shootingRectangles[DIRECTION_RIGHT].y - Renderer::displayY;
 		renderingRectangle.w = _shootingRectangles[DIRECTION_RIGHT].w;
 		renderingRectangle.h = _shootingRectangles[DIRECTION_RIGHT].h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
-		
-		SDL_SetRenderDrawColor(Renderer::pointerRenderer, 0, 0, 0, 255);
+		Renderer::renderRectangle(&renderingRectangle, 255, 0, 0);
 	}
 	#endif
 }
 
-int EnemyFightingEntity::_isShootPossible()
+int EnemyFightingEntity::_isShootPossible(Direction *pointerFacingDirection)
 {
 	// Is the player in line of sight ?
 	if (SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_shootingRectangles[DIRECTION_UP]))
 	{
 		// Shoot if the enemy is in the right direction
-		if (_facingDirection == DIRECTION_UP)
+		if (*pointerFacingDirection == DIRECTION_UP)
 		{
 			if (!LevelManager::isObstaclePresentOnVerticalAxis(pointerPlayer->getY(), getY(), getX())) return 1;
 		}
-		else turnToUp(); // Face right direction
+		else *pointerFacingDirection = DIRECTION_UP; // Face right direction
 	}
 	else if (SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_shootingRectangles[DIRECTION_DOWN]))
 	{
-		if (_facingDirection == DIRECTION_DOWN)
+		if (*pointerFacingDirection == DIRECTION_DOWN)
 		{
 			if (!LevelManager::isObstaclePresentOnVerticalAxis(getY(), pointerPlayer->getY(), getX())) return 1;
 		}
-		else turnToDown();
+		else *pointerFacingDirection = DIRECTION_DOWN;
 	}
 	else if (SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_shootingRectangles[DIRECTION_LEFT]))
 	{
-		if (_facingDirection == DIRECTION_LEFT)
+		if (*pointerFacingDirection == DIRECTION_LEFT)
 		{
 			if (!LevelManager::isObstaclePresentOnHorizontalAxis(pointerPlayer->getX(), getX(), getY())) return 1;
 		}
-		else turnToLeft();
+		else *pointerFacingDirection = DIRECTION_LEFT;
 	}
 	else if (SDL_HasIntersection(pointerPlayer->getPositionRectangle(), &_shootingRectangles[DIRECTION_RIGHT]))
 	{
-		if (_facingDirection == DIRECTION_RIGHT)
+		if (*pointerFacingDirection == DIRECTION_RIGHT)
 		{
 			if (!LevelManager::isObstaclePresentOnHorizontalAxis(getX(), pointerPlayer->getX(), getY())) return 1;
 		}
-		else turnToRight();
+		else *pointerFacingDirection = DIRECTION_RIGHT;
 	}
 	
 	return 0;
 }
 
-int EnemyFightingEntity::_getPlayerDirection(Direction *pointerDirection)
+int EnemyFightingEntity::_getPlayerDirection(Direction facingDirection, Direction *pointerDirection)
 {
 	// Compute both player and enemy centers
 	SDL_Rect *pointerPlayerPositionRectangle, *pointerEnemyPositionRectangle;
 	pointerPlayerPositionRectangle = pointerPlayer->getPositionRectangle();
-	pointerEnemyPositionRectangle = &_positionRectangles[_facingDirection];
+	pointerEnemyPositionRectangle = &_positionRectangles[facingDirection];
 	int enemyCenterX = pointerEnemyPositionRectangle->x + (pointerEnemyPositionRectangle->w / 2);
 	int enemyCenterY = pointerEnemyPositionRectangle->y + (pointerEnemyPositionRectangle->h / 2);
 	
@@ -297,9 +323,17 @@ int EnemyFightingEntity::_getPlayerDirection(Direction *pointerDirection)
 	if (horizontalDistance < 0) horizontalDistance = -horizontalDistance;
 	int verticalDistance = enemyCenterY - (pointerPlayerPositionRectangle->y + (pointerPlayerPositionRectangle->h / 2));
 	if (verticalDistance < 0) verticalDistance = -verticalDistance;
+	bool isHorizontalAxisPreferred = (horizontalDistance + 50 >= verticalDistance); // Add some distance to the player to avoid enemies collide with player
+	
+	// Walk around the obstacles until the player block is next to the enemy block
+	if (NavigationManager::getPlayerDistance(enemyCenterX, enemyCenterY) > 1)
+	{
+		*pointerDirection = _getPathDirection(pointerEnemyPositionRectangle, isHorizontalAxisPreferred);
+		return 1;
+	}
 	
 	// Try to come the most closer to the player by moving on the farther direction
-	if (horizontalDistance + 50 >= verticalDistance) // Add some distance to the player to avoid enemies collide with player
+	if (isHorizontalAxisPreferred)
 	{
 		// The enemy is too much on the player left to shoot
 		if (enemyCenterX < pointerPlayerPositionRectangle->x)
@@ -333,20 +367,133 @@ int EnemyFightingEntity::_getPlayerDirection(Direction *pointerDirection)
 	return 0;
 }
 
-void EnemyFightingEntity::_setBlockEnemyContent(bool isEnemyPresent)
+EnemyFightingEntity::Direction EnemyFightingEntity::_getPathDirection(SDL_Rect *pointerEnemyPositionRectangle, bool isHorizontalAxisPreferred)
+{
+	SDL_Rect *pointerPlayerPositionRectangle = pointerPlayer->getPositionRectangle();
+	int enemyCenterX = pointerEnemyPositionRectangle->x + (pointerEnemyPositionRectangle->w / 2);
+	int enemyCenterY = pointerEnemyPositionRectangle->y + (pointerEnemyPositionRectangle->h / 2);
+	
+	// Try the directions going toward the player first, on the farther axis first, so the enemy keeps its usual way when several paths have the same length
+	Direction horizontalDirection, verticalDirection, candidateDirections[DIRECTIONS_COUNT];
+	if (enemyCenterX < pointerPlayerPositionRectangle->x + (pointerPlayerPositionRectangle->w / 2)) horizontalDirection = DIRECTION_RIGHT;
+	else horizontalDirection = DIRECTION_LEFT;
+	if (enemyCenterY < pointerPlayerPositionRectangle->y + (pointerPlayerPositionRectangle->h / 2)) verticalDirection = DIRECTION_DOWN;
+	else verticalDirection = DIRECTION_UP;
+	if (isHorizontalAxisPreferred)
+	{
+		candidateDirections[0] = horizontalDirection;
+		candidateDirections[1] = verticalDirection;
+		candidateDirections[2] = (verticalDirection == DIRECTION_UP) ? DIRECTION_DOWN : DIRECTION_UP;
+		candidateDirections[3] = (horizontalDirection == DIRECTION_LEFT) ? DIRECTION_RIGHT : DIRECTION_LEFT;
+	}
+	else
+	{
+		candidateDirections[0] = verticalDirection;
+		candidateDirections[1] = horizontalDirection;
+		candidateDirections[2] = (horizontalDirection == DIRECTION_LEFT) ? DIRECTION_RIGHT : DIRECTION_LEFT;
+		candidateDirections[3] = (verticalDirection == DIRECTION_UP) ? DIRECTION_DOWN : DIRECTION_UP;
+	}
+	
+	// Go to the neighbor block the closest to the player, spread the enemies on the paths of the same length to avoid making a queue
+	Direction bestDirection = candidateDirections[0];
+	int i, bestDistance = -1, bestCrowdingCount = 0, distance, crowdingCount, neighborCenterX, neighborCenterY;
+	for (i = 0; i < DIRECTIONS_COUNT; i++)
+	{
+		_getNeighborBlockPoint(enemyCenterX, enemyCenterY, candidateDirections[i], &neighborCenterX, &neighborCenterY);
+		distance = NavigationManager::getPlayerDistance(neighborCenterX, neighborCenterY);
+		if ((distance < 0) || ((bestDistance != -1) && (distance > bestDistance))) continue;
+		
+		crowdingCount = LevelManager::getSurroundingEnemiesCount(neighborCenterX, neighborCenterY);
+		if ((bestDistance == -1) || (distance < bestDistance) || (crowdingCount < bestCrowdingCount))
+		{
+			bestDistance = distance;
+			bestCrowdingCount = crowdingCount;
+			bestDirection = candidateDirections[i];
+		}
+	}
+	
+	// The enemy can overlap two block rows or columns, center it on its block first if the other row or column is obstructed in the moving direction
+	int blockLeftX = (enemyCenterX / CONFIGURATION_LEVEL_BLOCK_SIZE) * CONFIGURATION_LEVEL_BLOCK_SIZE;
+	int blockTopY = (enemyCenterY / CONFIGURATION_LEVEL_BLOCK_SIZE) * CONFIGURATION_LEVEL_BLOCK_SIZE;
+	_getNeighborBlockPoint(enemyCenterX, enemyCenterY, bestDirection, &neighborCenterX, &neighborCenterY);
+	if ((bestDirection == DIRECTION_UP) || (bestDirection == DIRECTION_DOWN))
+	{
+		if ((pointerEnemyPositionRectangle->x < blockLeftX) && (NavigationManager::getPlayerDistance(pointerEnemyPositionRectangle->x, neighborCenterY) < 0)) return DIRECTION_RIGHT;
+		if ((pointerEnemyPositionRectangle->x + pointerEnemyPositionRectangle->w > blockLeftX + CONFIGURATION_LEVEL_BLOCK_SIZE) && (NavigationManager::getPlayerDistance(pointerEnemyPositionRectangle->x + pointerEnemyPositionRectangle->w - 1, neighborCenterY) < 0)) return DIRECTION_LEFT;
+	}
+	else
+	{
+		if ((pointerEnemyPositionRectangle->y < blockTopY) && (NavigationManager::getPlayerDistance(neighborCenterX, pointerEnemyPositionRectangle->y) < 0)) return DIRECTION_DOWN;
+		if ((pointerEnemyPositionRectangle->y + pointerEnemyPositionRectangle->h > blockTopY + CONFIGURATION_LEVEL_BLOCK_SIZE) && (NavigationManager::getPlayerDistance(neighborCenterX, pointerEnemyPositionRectangle->y + pointerEnemyPositionRectangle->h - 1) < 0)) return DIRECTION_UP;
+	}
+	
+	return bestDirection;
+}
+
+void EnemyFightingEntity::_getNeighborBlockPoint(int x, int y, Direction direction, int *pointerNeighborX, int *pointerNeighborY)
+{
+	*pointerNeighborX = x;
+	*pointerNeighborY = y;
+	switch (direction)
+	{
+		case DIRECTION_UP:
+			*pointerNeighborY -= CONFIGURATION_LEVEL_BLOCK_SIZE;
+			break;
+			
+		case DIRECTION_DOWN:
+			*pointerNeighborY += CONFIGURATION_LEVEL_BLOCK_SIZE;
+			break;
+			
+		case DIRECTION_LEFT:
+			*pointerNeighborX -= CONFIGURATION_LEVEL_BLOCK_SIZE;
+			break;
+			
+		default:
+			*pointerNeighborX += CONFIGURATION_LEVEL_BLOCK_SIZE;
+			break;
+	}
+}
+
+int EnemyFightingEntity::_getAvoidanceDirection(Direction blockedDirection, Direction *pointerDirection)
 {
-	// Cache enemy center coordinates
 	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
 	int enemyCenterX = pointerPositionRectangle->x + (pointerPositionRectangle->w / 2);
 	int enemyCenterY = pointerPositionRectangle->y + (pointerPositionRectangle->h / 2);
+	int i, distance, crowdingCount, bestDistance = -1, bestCrowdingCount = 0, neighborCenterX, neighborCenterY;
+	Direction direction;
 	
-	// Get current block content
-	int blockContent = LevelManager::getBlockContent(enemyCenterX, enemyCenterY);
-	
-	// Set or reset enemy flag
-	if (isEnemyPresent) blockContent |= LevelManager::BLOCK_CONTENT_ENEMY;
-	else blockContent &= ~LevelManager::BLOCK_CONTENT_ENEMY;
+	// Keep going toward the player as much as possible, then go where there are the less enemies
+	for (i = 0; i < DIRECTIONS_COUNT; i++)
+	{
+		direction = (Direction) i;
+		if (direction == blockedDirection) continue;
+		
+		// Do not try to enter a wall, an enemy spawner or a block taken by another enemy
+		_getNeighborBlockPoint(enemyCenterX, enemyCenterY, direction, &neighborCenterX, &neighborCenterY);
+		distance = NavigationManager::getPlayerDistance(neighborCenterX, neighborCenterY);
+		if ((distance < 0) || (LevelManager::getBlockEnemiesCount(neighborCenterX, neighborCenterY) > 0)) continue;
+		
+		crowdingCount = LevelManager::getSurroundingEnemiesCount(neighborCenterX, neighborCenterY);
+		if ((bestDistance == -1) || (distance < bestDistance) || ((distance == bestDistance) && (crowdingCount < bestCrowdingCount)))
+		{
+			bestDistance = distance;
+			bestCrowdingCount = crowdingCount;
+			*pointerDirection = direction;
+		}
+	}
 	
-	// Set new block content
-	LevelManager::setBlockContent(enemyCenterX, enemyCenterY, blockContent);
+	if (bestDistance == -1) return 0;
+	return 1;
+}
+
+void EnemyFightingEntity::_addToBlock()
+{
+	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
+	LevelManager::addBlockEnemy(pointerPositionRectangle->x + (pointerPositionRectangle->w / 2), pointerPositionRectangle->y + (pointerPositionRectangle->h / 2));
+}
+
+void EnemyFightingEntity::_removeFromBlock()
+{
+	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
+	LevelManager::removeBlockEnemy(pointerPositionRectangle->x + (pointerPositionRectangle->w / 2), pointerPositionRectangle->y + (pointerPositionRectangle->h / 2));
 }
@@ -5,6 +5,8 @@
 #include <AudioManager.hpp>
 #include <FightingEntity.hpp>
 #include <LevelManager.hpp>
+#include <SimulationClock.hpp>
+#include <TimerManager.hpp>
 
 FightingEntity::FightingEntity(int x, int y, TextureManager::TextureId textureId, int movingPixelsAmount, int maximumLifePointsAmount, int timeBetweenShots, TextureManager::TextureId facingUpBulletTextureId, EffectManager::EffectId firingEffectId): MovingEntity(x, y, textureId, movingPixelsAmount)
 {
@@ -24,10 +26,16 @@ FightingEntity::FightingEntity(int x, int y, TextureManager::TextureId textureId
 	_computeFiringEffectStartingPositionOffsets(_pointerTextures[DIRECTION_UP], firingEffectId, _firingEffectStartingPositionOffsets);
 	
 	_timeBetweenShots = timeBetweenShots;
-	_lastShotTime = 0; // Allow to shoot immediately
+	_lastShotTime = SimulationClock::getTime() - _timeBetweenShots; // Allow to shoot immediately
+	_reloadingTimerId = TimerManager::TIMER_ID_NONE;
+	_updateReloadingTimer();
 }
 
-FightingEntity::~FightingEntity() {}
+FightingEntity::~FightingEntity()
+{
+	// Do not let the timer access a deleted entity
+	TimerManager::cancel(_reloadingTimerId);
+}
 
 bool FightingEntity::modifyLife(int lifePointsAmount)
 {
@@ -43,7 +51,7 @@ bool FightingEntity::modifyLife(int lifePointsAmount)
 BulletMovingEntity *FightingEntity::shoot()
 {
 	// Allow to shoot only if enough time elapsed since last shot
-	if (SDL_GetTicks() - _lastShotTime >= _timeBetweenShots)
+	if (_isReloadingTimeElapsed)
 	{
 		// Cache entity coordinates
 		int entityX = _positionRectangles[_facingDirection].x;
@@ -70,8 +78,8 @@ BulletMovingEntity *FightingEntity::shoot()
 		EffectManager::EffectId muzzleFlashEffectId = (EffectManager::EffectId) ((int) _firingEffectId + (int) _facingDirection); // Select the right effect according to entity direction
 		EffectManager::addEffect(entityX + firingEffectStartingPositionOffsetX, entityY + firingEffectStartingPositionOffsetY, muzzleFlashEffectId, soundEmitterAngle, soundEmitterDistance);
 		
-		// Get time after having generated the bullet, in case this takes more than 1 millisecond
-		_lastShotTime = SDL_GetTicks();
+		_lastShotTime = SimulationClock::getTime();
+		_updateReloadingTimer();
 		
 		return pointerBullet;
 	}
@@ -114,3 +122,26 @@ void FightingEntity::_computeFiringEffectStartingPositionOffsets(Texture *pointe
 	pointerPositionOffsets[DIRECTION_RIGHT].x = pointerPositionOffsets[DIRECTION_DOWN].y;
 	pointerPositionOffsets[DIRECTION_RIGHT].y = pointerPositionOffsets[DIRECTION_UP].x;
 }
+
+void FightingEntity::_updateReloadingTimer()
+{
+	TimerManager::cancel(_reloadingTimerId);
+	_reloadingTimerId = TimerManager::TIMER_ID_NONE;
+	
+	// Use a signed difference to know whether the reloading time is already elapsed
+	int remainingReloadingTime = (int) (_lastShotTime + _timeBetweenShots - SimulationClock::getTime());
+	if (remainingReloadingTime <= 0) _isReloadingTimeElapsed = true;
+	else
+	{
+		_isReloadingTimeElapsed = false;
+		_reloadingTimerId = TimerManager::schedule(remainingReloadingTime, _reloadingTimerCallback, this);
+	}
+}
+
+void FightingEntity::_reloadingTimerCallback(void *pointerParameter)
+{
+	FightingEntity *pointerEntity = (FightingEntity *) pointerParameter;
+	
+	pointerEntity->_isReloadingTimeElapsed = true;
+	pointerEntity->_reloadingTimerId = TimerManager::TIMER_ID_NONE;
+}
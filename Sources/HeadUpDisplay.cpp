@@ -35,11 +35,25 @@ namespace HeadUpDisplay
 		bool isLighted; //!< Display lighted texture when true, display turned off texture when false.
 	} CompassArrow;
 
-	/** Cache all the pre-rendered string textures to avoid to render them at each frame, which is useless if they don't change. */
-	static SDL_Texture *_pointerStringTextures[STRING_IDS_COUNT] = {0};
+	/** A string and the color to display it with. */
+	typedef struct
+	{
+		char string[64]; //!< The text to display.
+		Renderer::TextColorId colorId; //!< The text color.
+	} HudString;
+
+	/** Cache all the strings to avoid to format them at each frame, which is useless if they don't change. */
+	static HudString _strings[STRING_IDS_COUNT];
 
-	/** Point to the interface background texture with the right type for the rendering function. */
-	static SDL_Texture *_pointerBackgroundTexture;
+	/** The interface background texture. */
+	static Texture *_pointerBackgroundTexture;
+
+	/** The panel (the background and the strings drawn on it) is drawn to this texture only when a string changes, or it is NULL if the panel must be drawn at each frame (in headless mode or if the renderer can't draw to textures). */
+	static SDL_Texture *_pointerPanelTexture;
+	/** Where the panel is displayed. */
+	static SDL_Rect _panelRectangle;
+	/** Tell whether a panel string changed since the panel texture was drawn. */
+	static bool _isPanelRedrawNeeded = true;
 
 	/** Tell whether bonus remaining time must be displayed. */
 	static bool _isBonusRemainingSecondsStringDisplayed = false;
@@ -47,69 +61,81 @@ namespace HeadUpDisplay
 	/** All compass arrows. */
 	static CompassArrow _compassArrows[COMPASS_ARROW_IDS_COUNT];
 
-	/** Display player life amount. */
-	static inline void _displayPlayerLifePointsAmount()
+	/** Update the player life amount string if the player life changed. */
+	static inline void _updatePlayerLifePointsAmountString()
 	{
-		// Check whether the string must be rendered
+		// Check whether the string must be updated
 		static int previousLifePointsAmount = -10; // This value can't be reached in game, so the string displaying is forced on game start
 		int lifePointsAmount = pointerPlayer->getLifePointsAmount();
 		if (lifePointsAmount != previousLifePointsAmount)
 		{
 			// Display life points in red if the player is near to death
-			Renderer::TextColorId colorId;
-			if (lifePointsAmount < 20) colorId = Renderer::TEXT_COLOR_ID_RED;
+			HudString *pointerString = &_strings[STRING_ID_LIFE_POINTS_AMOUNT];
+			if (lifePointsAmount < 20) pointerString->colorId = Renderer::TEXT_COLOR_ID_RED;
 			// Display life points in green if the player life is full
-			else if (lifePointsAmount == pointerPlayer->getMaximumLifePointsAmount()) colorId = Renderer::TEXT_COLOR_ID_GREEN;
-			else colorId = Renderer::TEXT_COLOR_ID_LIGHT_BLUE;
-			
-			// Free previous string
-			SDL_DestroyTexture(_pointerStringTextures[STRING_ID_LIFE_POINTS_AMOUNT]); // SDL_DestroyTexture() does not complain if the provided pointer is NULL, as it is on the first frame
+			else if (lifePointsAmount == pointerPlayer->getMaximumLifePointsAmount()) pointerString->colorId = Renderer::TEXT_COLOR_ID_GREEN;
+			else pointerString->colorId = Renderer::TEXT_COLOR_ID_LIGHT_BLUE;
 			
-			// Render the string
-			char string[64];
-			snprintf(string, sizeof(string), "Life : %d", lifePointsAmount);
-			_pointerStringTextures[STRING_ID_LIFE_POINTS_AMOUNT] = Renderer::renderTextToTexture(string, colorId, Renderer::FONT_SIZE_ID_SMALL);
+			// Update the string
+			snprintf(pointerString->string, sizeof(pointerString->string), "Life : %d", lifePointsAmount);
 			
 			previousLifePointsAmount = lifePointsAmount;
+			_isPanelRedrawNeeded = true;
 			LOG_DEBUG("Refreshed life points interface string.");
 		}
-		
-		// Render the string
-		Renderer::renderTexture(_pointerStringTextures[STRING_ID_LIFE_POINTS_AMOUNT], CONFIGURATION_DISPLAY_HUD_LIFE_POINTS_X, CONFIGURATION_DISPLAY_HUD_LIFE_POINTS_Y);
 	}
 
-	static inline void _displayPlayerAmmunitionAmount()
+	/** Update the player ammunition amount string if the player ammunition changed. */
+	static inline void _updatePlayerAmmunitionAmountString()
 	{
-		// Check whether the string must be rendered
+		// Check whether the string must be updated
 		static int previousAmmunitionAmount = -10; // This value can't be reached in game, so the string displaying is forced on game start
 		int ammunitionAmount = pointerPlayer->getAmmunitionAmount();
 		if (ammunitionAmount != previousAmmunitionAmount)
 		{
 			// Display ammunition in red if they are exhausted
-			Renderer::TextColorId colorId;
-			if (ammunitionAmount == 0) colorId = Renderer::TEXT_COLOR_ID_RED;
-			else colorId = Renderer::TEXT_COLOR_ID_LIGHT_BLUE;
-			
-			// Free previous string
-			SDL_DestroyTexture(_pointerStringTextures[STRING_ID_AMMUNITION_AMOUNT]);
+			HudString *pointerString = &_strings[STRING_ID_AMMUNITION_AMOUNT];
+			if (ammunitionAmount == 0) pointerString->colorId = Renderer::TEXT_COLOR_ID_RED;
+			else pointerString->colorId = Renderer::TEXT_COLOR_ID_LIGHT_BLUE;
 			
-			// Render the string
-			char string[64];
-			snprintf(string, sizeof(string), "Ammo : %d", ammunitionAmount);
-			_pointerStringTextures[STRING_ID_AMMUNITION_AMOUNT] = Renderer::renderTextToTexture(string, colorId, Renderer::FONT_SIZE_ID_SMALL);
+			// Update the string
+			snprintf(pointerString->string, sizeof(pointerString->string), "Ammo : %d", ammunitionAmount);
 			
 			previousAmmunitionAmount = ammunitionAmount;
+			_isPanelRedrawNeeded = true;
 			LOG_DEBUG("Refreshed ammunition interface string.");
 		}
+	}
+		
+	/** Display the background and the strings drawn on it.
+	* @param x The panel left coordinate.
+	* @param y The panel top coordinate.
+	*/
+	static void _renderPanel(int x, int y)
+	{
+		// The strings coordinates are configured for a panel displayed at its usual location
+		int offsetX = x - CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_X;
+		int offsetY = y - CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_Y;
 		
-		// Render the string
-		Renderer::renderTexture(_pointerStringTextures[STRING_ID_AMMUNITION_AMOUNT], CONFIGURATION_DISPLAY_HUD_AMMUNITION_X, CONFIGURATION_DISPLAY_HUD_AMMUNITION_Y);
+		_pointerBackgroundTexture->render(x, y);
+		Renderer::renderText(_strings[STRING_ID_LIFE_POINTS_AMOUNT].string, _strings[STRING_ID_LIFE_POINTS_AMOUNT].colorId, Renderer::FONT_SIZE_ID_SMALL, offsetX + CONFIGURATION_DISPLAY_HUD_LIFE_POINTS_X, offsetY + CONFIGURATION_DISPLAY_HUD_LIFE_POINTS_Y);
+		Renderer::renderText(_strings[STRING_ID_AMMUNITION_AMOUNT].string, _strings[STRING_ID_AMMUNITION_AMOUNT].colorId, Renderer::FONT_SIZE_ID_SMALL, offsetX + CONFIGURATION_DISPLAY_HUD_AMMUNITION_X, offsetY + CONFIGURATION_DISPLAY_HUD_AMMUNITION_Y);
+		Renderer::renderText(_strings[STRING_ID_ENEMIES_AMOUNT].string, _strings[STRING_ID_ENEMIES_AMOUNT].colorId, Renderer::FONT_SIZE_ID_SMALL, offsetX + CONFIGURATION_DISPLAY_HUD_ENEMIES_X, offsetY + CONFIGURATION_DISPLAY_HUD_ENEMIES_Y);
+		Renderer::renderText(_strings[STRING_ID_MORTAR_STATE].string, _strings[STRING_ID_MORTAR_STATE].colorId, Renderer::FONT_SIZE_ID_SMALL, offsetX + CONFIGURATION_DISPLAY_HUD_MORTAR_STATE_X, offsetY + CONFIGURATION_DISPLAY_HUD_MORTAR_STATE_Y);
 	}
 
 	int initialize()
 	{
 		// Cache background texture access to avoid searching for it at each frame
-		_pointerBackgroundTexture = getTextureFromId(TextureManager::TEXTURE_ID_HEAD_UP_DISPLAY_BACKGROUND)->getSDLTexture();
+		_pointerBackgroundTexture = getTextureFromId(TextureManager::TEXTURE_ID_HEAD_UP_DISPLAY_BACKGROUND);
+		
+		// Draw the panel once to a texture, it will be displayed with a single copy until a string changes
+		_panelRectangle.x = CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_X;
+		_panelRectangle.y = CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_Y;
+		_panelRectangle.w = _pointerBackgroundTexture->getWidth();
+		_panelRectangle.h = _pointerBackgroundTexture->getHeight();
+		_pointerPanelTexture = Renderer::createTargetTexture(_panelRectangle.w, _panelRectangle.h);
+		if ((_pointerPanelTexture == NULL) && !Renderer::isHeadlessModeEnabled) LOG_INFORMATION("The HUD panel will be drawn at each frame.");
 		
 		// Cache compass textures and position
 		// Down arrow
@@ -139,18 +165,14 @@ namespace HeadUpDisplay
 	void setEnemiesAmount(int amount)
 	{
 		// Display enemies in green if they are all dead and all enemy spawners are destroyed
-		Renderer::TextColorId colorId;
-		if ((amount == 0) && (LevelManager::enemySpawnersList.empty())) colorId = Renderer::TEXT_COLOR_ID_GREEN;
-		else colorId = Renderer::TEXT_COLOR_ID_LIGHT_BLUE;
-		
-		// Free previous string
-		SDL_DestroyTexture(_pointerStringTextures[STRING_ID_ENEMIES_AMOUNT]);
+		HudString *pointerString = &_strings[STRING_ID_ENEMIES_AMOUNT];
+		if ((amount == 0) && (LevelManager::enemySpawnersList.empty())) pointerString->colorId = Renderer::TEXT_COLOR_ID_GREEN;
+		else pointerString->colorId = Renderer::TEXT_COLOR_ID_LIGHT_BLUE;
 		
-		// Render the string
-		char string[64];
-		snprintf(string, sizeof(string), "Enemies : %d", amount);
-		_pointerStringTextures[STRING_ID_ENEMIES_AMOUNT] = Renderer::renderTextToTexture(string, colorId, Renderer::FONT_SIZE_ID_SMALL);
+		// Update the string
+		snprintf(pointerString->string, sizeof(pointerString->string), "Enemies : %d", amount);
 		
+		_isPanelRedrawNeeded = true;
 		LOG_DEBUG("Refreshed enemies interface string.");
 	}
 
@@ -158,30 +180,29 @@ namespace HeadUpDisplay
 	{
 		static MortarState previousMortarState = MORTAR_STATE_INVALID; // Initialize with an invalid value to make sure the first string is generated
 		
-		// Nothing to do if the string has been rendered yet
+		// Nothing to do if the string has been updated yet
 		if (state == previousMortarState) return;
 		
 		// Add string prefix
-		char string[64];
-		strcpy(string, "Mortar : ");
+		HudString *pointerString = &_strings[STRING_ID_MORTAR_STATE];
+		strcpy(pointerString->string, "Mortar : ");
 		
 		// Add string suffix and select color
-		Renderer::TextColorId colorId;
 		switch (state)
 		{
 			case MORTAR_STATE_LOW_AMMUNITION:
-				colorId = Renderer::TEXT_COLOR_ID_RED;
-				strcat(string, "low ammo");
+				pointerString->colorId = Renderer::TEXT_COLOR_ID_RED;
+				strcat(pointerString->string, "low ammo");
 				break;
 				
 			case MORTAR_STATE_RELOADING:
-				colorId = Renderer::TEXT_COLOR_ID_LIGHT_BLUE;
-				strcat(string, "reloading...");
+				pointerString->colorId = Renderer::TEXT_COLOR_ID_LIGHT_BLUE;
+				strcat(pointerString->string, "reloading...");
 				break;
 				
 			case MORTAR_STATE_READY:
-				colorId = Renderer::TEXT_COLOR_ID_GREEN;
-				strcat(string, "ready");
+				pointerString->colorId = Renderer::TEXT_COLOR_ID_GREEN;
+				strcat(pointerString->string, "ready");
 				break;
 				
 			default:
@@ -190,10 +211,8 @@ namespace HeadUpDisplay
 				break;
 		}
 		
-		// Render the string
-		_pointerStringTextures[STRING_ID_MORTAR_STATE] = Renderer::renderTextToTexture(string, colorId, Renderer::FONT_SIZE_ID_SMALL);
-		
 		previousMortarState = state;
+		_isPanelRedrawNeeded = true;
 	}
 
 	void setRemainingBonusTime(int timeSeconds)
@@ -204,13 +223,8 @@ namespace HeadUpDisplay
 			return;
 		}
 		
-		// Free previous string
-		SDL_DestroyTexture(_pointerStringTextures[STRING_ID_REMAINING_BONUS_TIME]);
-		
-		// Render the string
-		char string[64];
-		snprintf(string, sizeof(string), "Bonus time : %d", timeSeconds);
-		_pointerStringTextures[STRING_ID_REMAINING_BONUS_TIME] = Renderer::renderTextToTexture(string, Renderer::TEXT_COLOR_ID_BLUE, Renderer::FONT_SIZE_ID_BIG);
+		// Update the string
+		snprintf(_strings[STRING_ID_REMAINING_BONUS_TIME].string, sizeof(_strings[STRING_ID_REMAINING_BONUS_TIME].string), "Bonus time : %d", timeSeconds);
 		
 		_isBonusRemainingSecondsStringDisplayed = true;
 		
@@ -223,19 +237,31 @@ namespace HeadUpDisplay
 		_compassArrows[id].isLighted = isLighted;
 	}
 
+	void setPanelRedrawNeeded()
+	{
+		_isPanelRedrawNeeded = true;
+	}
+
 	void render()
 	{
-		// Display background
-		Renderer::renderTexture(_pointerBackgroundTexture, CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_X, CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_Y);
-		
-		// Display HUD content
-		_displayPlayerLifePointsAmount();
-		_displayPlayerAmmunitionAmount();
-		Renderer::renderTexture(_pointerStringTextures[STRING_ID_ENEMIES_AMOUNT], CONFIGURATION_DISPLAY_HUD_ENEMIES_X, CONFIGURATION_DISPLAY_HUD_ENEMIES_Y);
-		Renderer::renderTexture(_pointerStringTextures[STRING_ID_MORTAR_STATE], CONFIGURATION_DISPLAY_HUD_MORTAR_STATE_X, CONFIGURATION_DISPLAY_HUD_MORTAR_STATE_Y);
+		// Display the panel, drawing it again only if a string changed
+		_updatePlayerLifePointsAmountString();
+		_updatePlayerAmmunitionAmountString();
+		if (_pointerPanelTexture == NULL) _renderPanel(CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_X, CONFIGURATION_DISPLAY_HUD_BACKGROUND_TEXTURE_Y);
+		else
+		{
+			if (_isPanelRedrawNeeded)
+			{
+				Renderer::beginTextureDrawing(_pointerPanelTexture);
+				_renderPanel(0, 0);
+				Renderer::endTextureDrawing();
+				_isPanelRedrawNeeded = false;
+			}
+			Renderer::renderTextureArea(_pointerPanelTexture, NULL, &_panelRectangle);
+		}
 		
 		// Display bonus timer (if any)
-		if (_isBonusRemainingSecondsStringDisplayed) Renderer::renderCenteredTexture(_pointerStringTextures[STRING_ID_REMAINING_BONUS_TIME], CONFIGURATION_DISPLAY_HUD_BONUS_TIMER_Y);
+		if (_isBonusRemainingSecondsStringDisplayed) Renderer::renderText(_strings[STRING_ID_REMAINING_BONUS_TIME].string, Renderer::TEXT_COLOR_ID_BLUE, Renderer::FONT_SIZE_ID_BIG, -1, CONFIGURATION_DISPLAY_HUD_BONUS_TIMER_Y);
 		
 		// Display compass
 		for (int i = 0; i < COMPASS_ARROW_IDS_COUNT; i++)
@@ -0,0 +1,349 @@
+/** @file JobManager.cpp
+ * See JobManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Configuration.hpp>
+#include <JobManager.hpp>
+#include <Log.hpp>
+#include <SDL2/SDL.h>
+#include <vector>
+
+namespace JobManager
+{
+	/** The jobs submitted by a thread. The owning thread takes the newest jobs (they are more likely to use data still in the processor cache), other threads steal the oldest ones. */
+	typedef struct
+	{
+		Job jobs[CONFIGURATION_JOBS_QUEUE_SIZE]; //!< A circular buffer of jobs.
+		int oldestJobIndex; //!< The next job to steal.
+		int jobsCount; //!< How many jobs are queued.
+		SDL_SpinLock lock; //!< Protect the queue content.
+	} JobsQueue;
+
+	/** A range of items processed by a parallelFor() job. */
+	typedef struct
+	{
+		ParallelForFunction pointerFunction; //!< The function to call on the items.
+		void *pointerParameter; //!< The parameter to give to the function.
+		int firstItemIndex; //!< The first item to process.
+		int itemsCount; //!< How many items to process.
+	} ParallelForChunk;
+
+	/** All worker threads. */
+	static SDL_Thread *_pointerWorkerThreads[CONFIGURATION_JOBS_MAXIMUM_WORKER_THREADS_COUNT];
+	/** How many worker threads are running. */
+	static int _workerThreadsCount = 0;
+
+	/** One queue per thread, the first one belongs to the thread that initialized the job manager (the worker threads use the following ones). */
+	static JobsQueue _queues[CONFIGURATION_JOBS_MAXIMUM_WORKER_THREADS_COUNT + 1];
+	/** The queue owned by the current thread. */
+	static thread_local JobsQueue *_pointerCurrentThreadQueue = &_queues[0];
+	/** How many jobs are queued in all queues. */
+	static SDL_atomic_t _queuedJobsCount;
+
+	/** Protect the sleeping workers state. */
+	static SDL_mutex *_pointerMutex;
+	/** Wake the sleeping workers up when jobs are submitted. */
+	static SDL_cond *_pointerJobsAvailableCondition;
+	/** How many workers are waiting for jobs (the submitting threads do not need to take the mutex when nobody sleeps). */
+	static SDL_atomic_t _sleepingWorkersCount;
+	/** Tell the workers they must exit. */
+	static bool _isTerminationRequested = false;
+
+	/** Add a job to the current thread queue without waking the workers up.
+	* @param pointerJob The job to add.
+	* @return 0 if the job was queued,
+	* @return -1 if the queue is full.
+	*/
+	static int _queueJob(Job *pointerJob)
+	{
+		JobsQueue *pointerQueue = _pointerCurrentThreadQueue;
+		
+		SDL_AtomicLock(&pointerQueue->lock);
+		if (pointerQueue->jobsCount >= CONFIGURATION_JOBS_QUEUE_SIZE)
+		{
+			SDL_AtomicUnlock(&pointerQueue->lock);
+			return -1;
+		}
+		pointerQueue->jobs[(pointerQueue->oldestJobIndex + pointerQueue->jobsCount) % CONFIGURATION_JOBS_QUEUE_SIZE] = *pointerJob;
+		pointerQueue->jobsCount++;
+		SDL_AtomicUnlock(&pointerQueue->lock);
+		
+		SDL_AtomicAdd(&_queuedJobsCount, 1);
+		return 0;
+	}
+
+	/** Wake up the sleeping workers.
+	* @param jobsCount How many jobs have just been queued, so only the needed amount of workers is woken.
+	*/
+	static void _wakeWorkersUp(int jobsCount)
+	{
+		if (SDL_AtomicGet(&_sleepingWorkersCount) == 0) return;
+		
+		SDL_LockMutex(_pointerMutex);
+		if (jobsCount > 1) SDL_CondBroadcast(_pointerJobsAvailableCondition);
+		else SDL_CondSignal(_pointerJobsAvailableCondition);
+		SDL_UnlockMutex(_pointerMutex);
+	}
+
+	/** Take the newest job of the current thread queue, or steal the oldest job of another thread queue if the current thread has nothing to do.
+	* @param pointerJob On output, contain the taken job.
+	* @return true if a job was taken,
+	* @return false if all queues are empty.
+	*/
+	static bool _takeJob(Job *pointerJob)
+	{
+		JobsQueue *pointerQueue = _pointerCurrentThreadQueue;
+		int i, queuesCount = _workerThreadsCount + 1, queueIndex = pointerQueue - _queues;
+		
+		// Look in the own queue first
+		SDL_AtomicLock(&pointerQueue->lock);
+		if (pointerQueue->jobsCount > 0)
+		{
+			pointerQueue->jobsCount--;
+			*pointerJob = pointerQueue->jobs[(pointerQueue->oldestJobIndex + pointerQueue->jobsCount) % CONFIGURATION_JOBS_QUEUE_SIZE];
+			SDL_AtomicUnlock(&pointerQueue->lock);
+			SDL_AtomicAdd(&_queuedJobsCount, -1);
+			return true;
+		}
+		SDL_AtomicUnlock(&pointerQueue->lock);
+		
+		// Steal from the next threads (do not use rand() to choose the victim, it would change the game random numbers sequence)
+		for (i = 1; i < queuesCount; i++)
+		{
+			pointerQueue = &_queues[(queueIndex + i) % queuesCount];
+			
+			SDL_AtomicLock(&pointerQueue->lock);
+			if (pointerQueue->jobsCount > 0)
+			{
+				*pointerJob = pointerQueue->jobs[pointerQueue->oldestJobIndex];
+				pointerQueue->oldestJobIndex = (pointerQueue->oldestJobIndex + 1) % CONFIGURATION_JOBS_QUEUE_SIZE;
+				pointerQueue->jobsCount--;
+				SDL_AtomicUnlock(&pointerQueue->lock);
+				SDL_AtomicAdd(&_queuedJobsCount, -1);
+				return true;
+			}
+			SDL_AtomicUnlock(&pointerQueue->lock);
+		}
+		
+		return false;
+	}
+
+	/** Run a job, then update its group counter and submit the jobs depending on the group if it is finished.
+	* @param pointerJob The job to run.
+	*/
+	static void _runJob(Job *pointerJob)
+	{
+		JobCounter *pointerCounter = pointerJob->pointerCounter;
+		Job dependentJobs[CONFIGURATION_JOBS_MAXIMUM_DEPENDENT_JOBS_COUNT];
+		int i, dependentJobsCount = 0;
+		
+		pointerJob->pointerFunction(pointerJob->pointerParameter);
+		if (pointerCounter == NULL) return;
+		
+		// Decrement the counter with the lock held, so a thread waiting for the counter can't free it while the dependent jobs are still being read
+		SDL_AtomicLock(&pointerCounter->lock);
+		if (SDL_AtomicAdd(&pointerCounter->unfinishedJobsCount, -1) == 1)
+		{
+			dependentJobsCount = pointerCounter->dependentJobsCount;
+			for (i = 0; i < dependentJobsCount; i++) dependentJobs[i] = pointerCounter->dependentJobs[i];
+			pointerCounter->dependentJobsCount = 0;
+		}
+		SDL_AtomicUnlock(&pointerCounter->lock);
+		
+		// The counter must not be accessed anymore, it may have been freed
+		for (i = 0; i < dependentJobsCount; i++)
+		{
+			if (_queueJob(&dependentJobs[i]) != 0) _runJob(&dependentJobs[i]);
+		}
+		if (dependentJobsCount > 0) _wakeWorkersUp(dependentJobsCount);
+	}
+
+	/** Run jobs until termination is requested, sleep when there is no job to run.
+	* @param pointerQueue The queue owned by the worker.
+	* @return Always 0.
+	*/
+	static int _workerThread(void *pointerQueue)
+	{
+		Job job;
+		
+		_pointerCurrentThreadQueue = static_cast<JobsQueue *>(pointerQueue);
+		
+		while (1)
+		{
+			if (_takeJob(&job))
+			{
+				_runJob(&job);
+				continue;
+			}
+			
+			// Sleep until jobs are submitted (announce the sleeping worker before checking the jobs count, so a submitting thread can't miss it)
+			SDL_LockMutex(_pointerMutex);
+			SDL_AtomicAdd(&_sleepingWorkersCount, 1);
+			while ((SDL_AtomicGet(&_queuedJobsCount) == 0) && !_isTerminationRequested) SDL_CondWait(_pointerJobsAvailableCondition, _pointerMutex);
+			SDL_AtomicAdd(&_sleepingWorkersCount, -1);
+			if (_isTerminationRequested)
+			{
+				SDL_UnlockMutex(_pointerMutex);
+				return 0;
+			}
+			SDL_UnlockMutex(_pointerMutex);
+		}
+	}
+
+	/** Run a parallelFor() range of items.
+	* @param pointerParameter The range description.
+	*/
+	static void _runParallelForChunk(void *pointerParameter)
+	{
+		ParallelForChunk *pointerChunk = static_cast<ParallelForChunk *>(pointerParameter);
+		pointerChunk->pointerFunction(pointerChunk->pointerParameter, pointerChunk->firstItemIndex, pointerChunk->itemsCount);
+	}
+
+	int initialize()
+	{
+		char stringThreadName[32];
+		
+		// Create synchronization objects
+		_pointerMutex = SDL_CreateMutex();
+		_pointerJobsAvailableCondition = SDL_CreateCond();
+		if ((_pointerMutex == NULL) || (_pointerJobsAvailableCondition == NULL))
+		{
+			LOG_ERROR("Failed to create the worker threads synchronization objects (%s).", SDL_GetError());
+			return -1;
+		}
+		SDL_AtomicSet(&_queuedJobsCount, 0);
+		SDL_AtomicSet(&_sleepingWorkersCount, 0);
+		_isTerminationRequested = false;
+		
+		// The calling thread runs jobs too, so start a worker only for the other cores
+		int workerThreadsCount = SDL_GetCPUCount() - 1;
+		if (workerThreadsCount > CONFIGURATION_JOBS_MAXIMUM_WORKER_THREADS_COUNT) workerThreadsCount = CONFIGURATION_JOBS_MAXIMUM_WORKER_THREADS_COUNT;
+		
+		for (_workerThreadsCount = 0; _workerThreadsCount < workerThreadsCount; _workerThreadsCount++)
+		{
+			snprintf(stringThreadName, sizeof(stringThreadName), "Worker %d", _workerThreadsCount);
+			_pointerWorkerThreads[_workerThreadsCount] = SDL_CreateThread(_workerThread, stringThreadName, &_queues[_workerThreadsCount + 1]);
+			if (_pointerWorkerThreads[_workerThreadsCount] == NULL)
+			{
+				LOG_ERROR("Failed to create worker thread %d (%s).", _workerThreadsCount, SDL_GetError());
+				return -1;
+			}
+		}
+		
+		LOG_INFORMATION("Started %d worker threads.", _workerThreadsCount);
+		return 0;
+	}
+
+	void uninitialize()
+	{
+		// Tell all workers to exit
+		SDL_LockMutex(_pointerMutex);
+		_isTerminationRequested = true;
+		SDL_CondBroadcast(_pointerJobsAvailableCondition);
+		SDL_UnlockMutex(_pointerMutex);
+		
+		// Wait for all of them
+		for (int i = 0; i < _workerThreadsCount; i++) SDL_WaitThread(_pointerWorkerThreads[i], NULL);
+		_workerThreadsCount = 0;
+		
+		SDL_DestroyCond(_pointerJobsAvailableCondition);
+		SDL_DestroyMutex(_pointerMutex);
+	}
+
+	void initializeCounter(JobCounter *pointerCounter)
+	{
+		SDL_AtomicSet(&pointerCounter->unfinishedJobsCount, 0);
+		pointerCounter->lock = 0;
+		pointerCounter->dependentJobsCount = 0;
+	}
+
+	void submitJob(JobFunction pointerFunction, void *pointerParameter, JobCounter *pointerCounter, JobCounter *pointerDependencyCounter)
+	{
+		Job job = {pointerFunction, pointerParameter, pointerCounter};
+		
+		if (pointerCounter != NULL) SDL_AtomicAdd(&pointerCounter->unfinishedJobsCount, 1);
+		
+		// Let the last job of the dependency group submit this job
+		if (pointerDependencyCounter != NULL)
+		{
+			SDL_AtomicLock(&pointerDependencyCounter->lock);
+			if ((SDL_AtomicGet(&pointerDependencyCounter->unfinishedJobsCount) > 0) && (pointerDependencyCounter->dependentJobsCount < CONFIGURATION_JOBS_MAXIMUM_DEPENDENT_JOBS_COUNT))
+			{
+				pointerDependencyCounter->dependentJobs[pointerDependencyCounter->dependentJobsCount] = job;
+				pointerDependencyCounter->dependentJobsCount++;
+				SDL_AtomicUnlock(&pointerDependencyCounter->lock);
+				return;
+			}
+			SDL_AtomicUnlock(&pointerDependencyCounter->lock);
+			
+			// There is no more room for dependent jobs, wait for the group here (nothing is waited if the group is already finished)
+			waitForCounter(pointerDependencyCounter);
+		}
+		
+		// Nobody would run the job if the queue is full, so run it immediately
+		if (_queueJob(&job) != 0)
+		{
+			_runJob(&job);
+			return;
+		}
+		_wakeWorkersUp(1);
+	}
+
+	void waitForCounter(JobCounter *pointerCounter)
+	{
+		Job job;
+		
+		// Help running the jobs instead of sleeping, the waited jobs may even be in the current thread queue
+		while (SDL_AtomicGet(&pointerCounter->unfinishedJobsCount) > 0)
+		{
+			if (_takeJob(&job)) _runJob(&job);
+			else SDL_Delay(0); // The last jobs are being run by other threads, let them progress
+		}
+		
+		// Make sure the thread that ran the last job does not access the counter anymore, so the caller can free it
+		SDL_AtomicLock(&pointerCounter->lock);
+		SDL_AtomicUnlock(&pointerCounter->lock);
+	}
+
+	void parallelFor(int itemsCount, ParallelForFunction pointerFunction, void *pointerParameter)
+	{
+		// Do not bother the workers when the items fit in a single chunk
+		if ((_workerThreadsCount == 0) || (itemsCount <= CONFIGURATION_JOBS_PARALLEL_FOR_CHUNK_SIZE))
+		{
+			if (itemsCount > 0) pointerFunction(pointerParameter, 0, itemsCount);
+			return;
+		}
+		
+		// Split the items into chunks (the last chunk can be smaller)
+		int i, chunksCount = (itemsCount + CONFIGURATION_JOBS_PARALLEL_FOR_CHUNK_SIZE - 1) / CONFIGURATION_JOBS_PARALLEL_FOR_CHUNK_SIZE;
+		std::vector<ParallelForChunk> chunks(chunksCount);
+		for (i = 0; i < chunksCount; i++)
+		{
+			chunks[i].pointerFunction = pointerFunction;
+			chunks[i].pointerParameter = pointerParameter;
+			chunks[i].firstItemIndex = i * CONFIGURATION_JOBS_PARALLEL_FOR_CHUNK_SIZE;
+			chunks[i].itemsCount = itemsCount - chunks[i].firstItemIndex;
+			if (chunks[i].itemsCount > CONFIGURATION_JOBS_PARALLEL_FOR_CHUNK_SIZE) chunks[i].itemsCount = CONFIGURATION_JOBS_PARALLEL_FOR_CHUNK_SIZE;
+		}
+		
+		// Queue one job per chunk, then wake all workers at once
+		JobCounter counter;
+		Job job = {_runParallelForChunk, NULL, &counter};
+		initializeCounter(&counter);
+		SDL_AtomicSet(&counter.unfinishedJobsCount, chunksCount);
+		for (i = 0; i < chunksCount; i++)
+		{
+			job.pointerParameter = &chunks[i];
+			if (_queueJob(&job) != 0) _runJob(&job);
+		}
+		_wakeWorkersUp(chunksCount);
+		
+		// Take part in the work
+		waitForCounter(&counter);
+	}
+
+	int getThreadsCount()
+	{
+		return _workerThreadsCount + 1;
+	}
+}
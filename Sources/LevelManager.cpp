@@ -6,15 +6,18 @@
 #include <cerrno>
 #include <Configuration.hpp>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <FileManager.hpp>
 #include <LevelManager.hpp>
 #include <list>
 #include <Log.hpp>
+#include <NavigationManager.hpp>
 #include <PlayerFightingEntity.hpp>
 #include <Renderer.hpp>
 #include <Texture.hpp>
 #include <TextureManager.hpp>
+#include <VisibilityManager.hpp>
 
 namespace LevelManager
 {
@@ -57,6 +60,25 @@ namespace LevelManager
 	/** Contain all level blocks. */
 	static Block _levelBlocks[CONFIGURATION_LEVEL_MAXIMUM_WIDTH * CONFIGURATION_LEVEL_MAXIMUM_HEIGHT];
 
+	/** How many enemy centers are on each block. */
+	static unsigned char _blockEnemiesCounts[CONFIGURATION_LEVEL_MAXIMUM_WIDTH * CONFIGURATION_LEVEL_MAXIMUM_HEIGHT];
+
+	/** The vertical visibility segment of each block, blocks of a column with the same segment are not separated by a wall or an enemy spawner (this is the amount of obstacles located above the block in its column). */
+	static int _columnSegmentIndexes[CONFIGURATION_LEVEL_MAXIMUM_WIDTH * CONFIGURATION_LEVEL_MAXIMUM_HEIGHT];
+	/** The horizontal visibility segment of each block, blocks of a row with the same segment are not separated by a wall or an enemy spawner (this is the amount of obstacles located on the left of the block in its row). */
+	static int _rowSegmentIndexes[CONFIGURATION_LEVEL_MAXIMUM_WIDTH * CONFIGURATION_LEVEL_MAXIMUM_HEIGHT];
+
+	/** How many enemy spawners are located on each level row. */
+	static int _rowEnemySpawnersCounts[CONFIGURATION_LEVEL_MAXIMUM_HEIGHT];
+	/** How many enemy spawners are located on each level column. */
+	static int _columnEnemySpawnersCounts[CONFIGURATION_LEVEL_MAXIMUM_WIDTH];
+	/** How many enemy spawners are located above, below, on the left and on the right of the reference block (indexed by MovingEntity::Direction). */
+	static int _directionEnemySpawnersCounts[MovingEntity::DIRECTIONS_COUNT];
+	/** The block the direction counts are computed from (in blocks). */
+	static int _referenceBlockX;
+	/** The block the direction counts are computed from (in blocks). */
+	static int _referenceBlockY;
+
 	/** Cache medipack texture. */
 	static Texture *_pointerMedipackTexture;
 	/** Cache golden medipack texture. */
@@ -68,6 +90,70 @@ namespace LevelManager
 	/** Cache bulletproof vest bonus texture. */
 	static Texture *_pointerBulletproofVestBonusTexture;
 
+	/** Split all level rows and columns into segments free of walls and enemy spawners. */
+	static void _computeVisibilitySegments()
+	{
+		int x, y, segmentIndex;
+		
+		for (x = 0; x < _levelWidthBlocks; x++)
+		{
+			segmentIndex = 0;
+			for (y = 0; y < _levelHeightBlocks; y++)
+			{
+				_columnSegmentIndexes[COMPUTE_BLOCK_INDEX(x, y)] = segmentIndex;
+				if (_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content & (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)) segmentIndex++; // The next block is on the other side of the obstacle
+			}
+		}
+		
+		for (y = 0; y < _levelHeightBlocks; y++)
+		{
+			segmentIndex = 0;
+			for (x = 0; x < _levelWidthBlocks; x++)
+			{
+				_rowSegmentIndexes[COMPUTE_BLOCK_INDEX(x, y)] = segmentIndex;
+				if (_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content & (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)) segmentIndex++;
+			}
+		}
+	}
+
+	/** Add or remove an enemy spawner from the rows, columns and directions counts.
+	* @param xBlock The spawner X coordinate (in blocks).
+	* @param yBlock The spawner Y coordinate (in blocks).
+	* @param countOffset 1 to add the spawner, -1 to remove it.
+	*/
+	static void _addEnemySpawnerCount(int xBlock, int yBlock, int countOffset)
+	{
+		_rowEnemySpawnersCounts[yBlock] += countOffset;
+		_columnEnemySpawnersCounts[xBlock] += countOffset;
+		
+		if (yBlock < _referenceBlockY) _directionEnemySpawnersCounts[MovingEntity::DIRECTION_UP] += countOffset;
+		else if (yBlock > _referenceBlockY) _directionEnemySpawnersCounts[MovingEntity::DIRECTION_DOWN] += countOffset;
+		if (xBlock < _referenceBlockX) _directionEnemySpawnersCounts[MovingEntity::DIRECTION_LEFT] += countOffset;
+		else if (xBlock > _referenceBlockX) _directionEnemySpawnersCounts[MovingEntity::DIRECTION_RIGHT] += countOffset;
+	}
+
+	/** Count the enemy spawners of the level that has just been loaded, the reference block is the player one. */
+	static void _computeEnemySpawnersCounts()
+	{
+		memset(_rowEnemySpawnersCounts, 0, sizeof(_rowEnemySpawnersCounts));
+		memset(_columnEnemySpawnersCounts, 0, sizeof(_columnEnemySpawnersCounts));
+		memset(_directionEnemySpawnersCounts, 0, sizeof(_directionEnemySpawnersCounts));
+		_referenceBlockX = pointerPlayer->getX() / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		_referenceBlockY = pointerPlayer->getY() / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+		for (enemySpawnersListIterator = enemySpawnersList.begin(); enemySpawnersListIterator != enemySpawnersList.end(); ++enemySpawnersListIterator) _addEnemySpawnerCount((*enemySpawnersListIterator)->getX() / CONFIGURATION_LEVEL_BLOCK_SIZE, (*enemySpawnersListIterator)->getY() / CONFIGURATION_LEVEL_BLOCK_SIZE, 1);
+	}
+
+	/** Create the visibility cells of the level that has just been loaded and store the enemy spawners in them. */
+	static void _storeVisibleEnemySpawners()
+	{
+		VisibilityManager::loadLevel(_levelWidthBlocks, _levelHeightBlocks);
+		
+		std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+		for (enemySpawnersListIterator = enemySpawnersList.begin(); enemySpawnersListIterator != enemySpawnersList.end(); ++enemySpawnersListIterator) VisibilityManager::addEntity(*enemySpawnersListIterator, VisibilityManager::ENTITY_TYPE_ENEMY_SPAWNER);
+	}
+
 	// Public variable, documentation is in the header file
 	std::list<EnemySpawnerStaticEntity *> enemySpawnersList;
 
@@ -115,6 +201,7 @@ namespace LevelManager
 		
 		_levelWidthBlocks = 0;
 		_levelHeightBlocks = 0;
+		memset(_blockEnemiesCounts, 0, sizeof(_blockEnemiesCounts)); // No enemy has been spawned yet
 		
 		// Parse the whole file considering it does not contain errors
 		i = 0;
@@ -250,6 +337,12 @@ namespace LevelManager
 		
 		fclose(pointerFile);
 		
+		// Find the paths and the lines of sight through the new level
+		NavigationManager::loadLevel(_levelWidthBlocks, _levelHeightBlocks);
+		_computeVisibilitySegments();
+		_computeEnemySpawnersCounts();
+		_storeVisibleEnemySpawners();
+		
 		LOG_INFORMATION("Level %d successfully loaded.", levelNumber);
 		return 0;
 		
@@ -258,6 +351,79 @@ namespace LevelManager
 		return -1;
 	}
 
+	int generateArena(int sizeBlocks, int enemySpawnersCount)
+	{
+		int x, y, i, attemptsCount, playerBlockCoordinate;
+		
+		// The arena must fit in the level and leave room for the player
+		if ((sizeBlocks < 8) || (sizeBlocks > CONFIGURATION_LEVEL_MAXIMUM_WIDTH) || (sizeBlocks > CONFIGURATION_LEVEL_MAXIMUM_HEIGHT))
+		{
+			LOG_ERROR("Bad arena size %d blocks.", sizeBlocks);
+			return -1;
+		}
+		_levelWidthBlocks = sizeBlocks;
+		_levelHeightBlocks = sizeBlocks;
+		memset(_blockEnemiesCounts, 0, sizeof(_blockEnemiesCounts));
+		
+		// Surround the floor with walls and add some pillars to give the enemies obstacles to walk around
+		for (y = 0; y < _levelHeightBlocks; y++)
+		{
+			for (x = 0; x < _levelWidthBlocks; x++)
+			{
+				i = COMPUTE_BLOCK_INDEX(x, y);
+				if ((x == 0) || (y == 0) || (x == _levelWidthBlocks - 1) || (y == _levelHeightBlocks - 1) || ((x % 8 == 4) && (y % 8 == 4)))
+				{
+					_levelBlocks[i].pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_SCENE_WALL_0);
+					_levelBlocks[i].content = BLOCK_CONTENT_WALL;
+				}
+				else
+				{
+					_levelBlocks[i].pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_SCENE_FLOOR_0);
+					_levelBlocks[i].content = 0;
+				}
+			}
+		}
+		
+		// Put the player at the center block (remove the pillar that could be here)
+		playerBlockCoordinate = sizeBlocks / 2;
+		i = COMPUTE_BLOCK_INDEX(playerBlockCoordinate, playerBlockCoordinate);
+		_levelBlocks[i].pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_SCENE_FLOOR_0);
+		_levelBlocks[i].content = 0;
+		Texture *pointerTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_UP);
+		pointerPlayer->setX((playerBlockCoordinate * CONFIGURATION_LEVEL_BLOCK_SIZE) + ((CONFIGURATION_LEVEL_BLOCK_SIZE - pointerTexture->getWidth()) / 2));
+		pointerPlayer->setY((playerBlockCoordinate * CONFIGURATION_LEVEL_BLOCK_SIZE) + ((CONFIGURATION_LEVEL_BLOCK_SIZE - pointerTexture->getHeight()) / 2));
+		
+		// Place the spawners on free blocks, not too close to the player to let the spawned enemies walk toward it
+		for (i = 0; i < enemySpawnersCount; i++)
+		{
+			for (attemptsCount = 0; attemptsCount < 100; attemptsCount++)
+			{
+				x = 1 + (rand() % (_levelWidthBlocks - 2));
+				y = 1 + (rand() % (_levelHeightBlocks - 2));
+				if ((abs(x - playerBlockCoordinate) < 3) && (abs(y - playerBlockCoordinate) < 3)) continue;
+				if (_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content == 0) break;
+			}
+			
+			// The arena is too crowded
+			if (attemptsCount == 100)
+			{
+				LOG_INFORMATION("Could place only %d enemy spawners among the %d requested ones.", i, enemySpawnersCount);
+				break;
+			}
+			
+			enemySpawnersList.push_front(new EnemySpawnerStaticEntity(x * CONFIGURATION_LEVEL_BLOCK_SIZE, y * CONFIGURATION_LEVEL_BLOCK_SIZE));
+			_levelBlocks[COMPUTE_BLOCK_INDEX(x, y)].content |= BLOCK_CONTENT_ENEMY_SPAWNER;
+		}
+		
+		NavigationManager::loadLevel(_levelWidthBlocks, _levelHeightBlocks);
+		_computeVisibilitySegments();
+		_computeEnemySpawnersCounts();
+		_storeVisibleEnemySpawners();
+		
+		LOG_INFORMATION("Generated a %dx%d blocks arena with %d enemy spawners.", _levelWidthBlocks, _levelHeightBlocks, i);
+		return 0;
+	}
+
 	void renderScene(int topLeftX, int topLeftY)
 	{
 		// Get the amount of pixels the rendering must be shifted about in the beginning blocks
@@ -398,14 +564,9 @@ namespace LevelManager
 		assert(x >= 0);
 		assert(x < _levelWidthBlocks);
 		
-		// Check all blocks along between the specified coordinates
-		while (topmostY < downerY)
-		{
-			if (_levelBlocks[COMPUTE_BLOCK_INDEX(x, topmostY)].content & (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)) return true;
-			topmostY++;
-		}
-		
-		return false;
+		// An obstacle between the blocks (the downer block excepted) puts them in different segments
+		if (topmostY >= downerY) return false;
+		return _columnSegmentIndexes[COMPUTE_BLOCK_INDEX(x, topmostY)] != _columnSegmentIndexes[COMPUTE_BLOCK_INDEX(x, downerY)];
 	}
 
 	bool isObstaclePresentOnHorizontalAxis(int leftmostX, int rightmostX, int y)
@@ -423,14 +584,9 @@ namespace LevelManager
 		assert(y >= 0);
 		assert(y < _levelHeightBlocks);
 		
-		// Check all blocks along between the specified coordinates
-		while (leftmostX < rightmostX)
-		{
-			if (_levelBlocks[COMPUTE_BLOCK_INDEX(leftmostX, y)].content & (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)) return true;
-			leftmostX++;
-		}
-		
-		return false;
+		// An obstacle between the blocks (the rightmost block excepted) puts them in different segments
+		if (leftmostX >= rightmostX) return false;
+		return _rowSegmentIndexes[COMPUTE_BLOCK_INDEX(leftmostX, y)] != _rowSegmentIndexes[COMPUTE_BLOCK_INDEX(rightmostX, y)];
 	}
 
 	int getBlockContent(int x, int y)
@@ -460,7 +616,140 @@ namespace LevelManager
 		assert(yBlock >= 0);
 		assert(yBlock < _levelHeightBlocks);
 		
-		_levelBlocks[COMPUTE_BLOCK_INDEX(xBlock, yBlock)].content = content;
+		// The paths to the player change only if the block becomes an obstacle or stops being one (replacing a wall by an enemy spawner does not change anything)
+		int blockIndex = COMPUTE_BLOCK_INDEX(xBlock, yBlock);
+		bool isObstacle = (content & (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)) != 0;
+		if (((_levelBlocks[blockIndex].content & (BLOCK_CONTENT_WALL | BLOCK_CONTENT_ENEMY_SPAWNER)) != 0) != isObstacle)
+		{
+			NavigationManager::setBlockModified(x, y);
+			
+			// Merge or split the segments of the block row and column, only the blocks after the obstacle are moved to another segment
+			int segmentOffset;
+			if (isObstacle) segmentOffset = 1;
+			else segmentOffset = -1;
+			for (int i = yBlock + 1; i < _levelHeightBlocks; i++) _columnSegmentIndexes[COMPUTE_BLOCK_INDEX(xBlock, i)] += segmentOffset;
+			for (int i = xBlock + 1; i < _levelWidthBlocks; i++) _rowSegmentIndexes[COMPUTE_BLOCK_INDEX(i, yBlock)] += segmentOffset;
+		}
+		
+		// Keep the enemy spawners counts up to date
+		if ((_levelBlocks[blockIndex].content ^ content) & BLOCK_CONTENT_ENEMY_SPAWNER)
+		{
+			if (content & BLOCK_CONTENT_ENEMY_SPAWNER) _addEnemySpawnerCount(xBlock, yBlock, 1);
+			else _addEnemySpawnerCount(xBlock, yBlock, -1);
+		}
+		
+		_levelBlocks[blockIndex].content = content;
+	}
+
+	void setEnemySpawnersReferenceBlock(int x, int y)
+	{
+		// Convert coordinates to blocks
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		// Move the reference block one row or one column at a time, so only the spawners of the crossed rows and columns change of direction (the player moves less than a block between two ticks)
+		while (_referenceBlockY < yBlock)
+		{
+			_directionEnemySpawnersCounts[MovingEntity::DIRECTION_UP] += _rowEnemySpawnersCounts[_referenceBlockY];
+			_referenceBlockY++;
+			_directionEnemySpawnersCounts[MovingEntity::DIRECTION_DOWN] -= _rowEnemySpawnersCounts[_referenceBlockY];
+		}
+		while (_referenceBlockY > yBlock)
+		{
+			_directionEnemySpawnersCounts[MovingEntity::DIRECTION_DOWN] += _rowEnemySpawnersCounts[_referenceBlockY];
+			_referenceBlockY--;
+			_directionEnemySpawnersCounts[MovingEntity::DIRECTION_UP] -= _rowEnemySpawnersCounts[_referenceBlockY];
+		}
+		while (_referenceBlockX < xBlock)
+		{
+			_directionEnemySpawnersCounts[MovingEntity::DIRECTION_LEFT] += _columnEnemySpawnersCounts[_referenceBlockX];
+			_referenceBlockX++;
+			_directionEnemySpawnersCounts[MovingEntity::DIRECTION_RIGHT] -= _columnEnemySpawnersCounts[_referenceBlockX];
+		}
+		while (_referenceBlockX > xBlock)
+		{
+			_directionEnemySpawnersCounts[MovingEntity::DIRECTION_RIGHT] += _columnEnemySpawnersCounts[_referenceBlockX];
+			_referenceBlockX--;
+			_directionEnemySpawnersCounts[MovingEntity::DIRECTION_LEFT] -= _columnEnemySpawnersCounts[_referenceBlockX];
+		}
+	}
+	
+	int getEnemySpawnersCount(MovingEntity::Direction direction)
+	{
+		return _directionEnemySpawnersCounts[direction];
+	}
+
+	void addBlockEnemy(int x, int y)
+	{
+		// Convert coordinates to blocks
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		// Make sure the block is existing
+		assert(xBlock >= 0);
+		assert(xBlock < _levelWidthBlocks);
+		assert(yBlock >= 0);
+		assert(yBlock < _levelHeightBlocks);
+		
+		int blockIndex = COMPUTE_BLOCK_INDEX(xBlock, yBlock);
+		assert(_blockEnemiesCounts[blockIndex] < 255);
+		_blockEnemiesCounts[blockIndex]++;
+		_levelBlocks[blockIndex].content |= BLOCK_CONTENT_ENEMY;
+	}
+
+	void removeBlockEnemy(int x, int y)
+	{
+		// Convert coordinates to blocks
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		// Make sure the block is existing
+		assert(xBlock >= 0);
+		assert(xBlock < _levelWidthBlocks);
+		assert(yBlock >= 0);
+		assert(yBlock < _levelHeightBlocks);
+		
+		int blockIndex = COMPUTE_BLOCK_INDEX(xBlock, yBlock);
+		assert(_blockEnemiesCounts[blockIndex] > 0);
+		_blockEnemiesCounts[blockIndex]--;
+		
+		// Keep the flag while other enemies are on the block
+		if (_blockEnemiesCounts[blockIndex] == 0) _levelBlocks[blockIndex].content &= ~BLOCK_CONTENT_ENEMY;
+	}
+
+	int getBlockEnemiesCount(int x, int y)
+	{
+		// Convert coordinates to blocks
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		// Make sure the block is existing
+		assert(xBlock >= 0);
+		assert(xBlock < _levelWidthBlocks);
+		assert(yBlock >= 0);
+		assert(yBlock < _levelHeightBlocks);
+		
+		return _blockEnemiesCounts[COMPUTE_BLOCK_INDEX(xBlock, yBlock)];
+	}
+
+	int getSurroundingEnemiesCount(int x, int y)
+	{
+		// Convert coordinates to blocks
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int enemiesCount = 0, xNeighbor, yNeighbor;
+		
+		// Ignore the blocks outside of the level
+		for (yNeighbor = yBlock - 1; yNeighbor <= yBlock + 1; yNeighbor++)
+		{
+			if ((yNeighbor < 0) || (yNeighbor >= _levelHeightBlocks)) continue;
+			for (xNeighbor = xBlock - 1; xNeighbor <= xBlock + 1; xNeighbor++)
+			{
+				if ((xNeighbor >= 0) && (xNeighbor < _levelWidthBlocks)) enemiesCount += _blockEnemiesCounts[COMPUTE_BLOCK_INDEX(xNeighbor, yNeighbor)];
+			}
+		}
+		
+		return enemiesCount;
 	}
 
 	void spawnItem(int x, int y)
@@ -2,6 +2,7 @@
  * Initialize the game engine and run the game.
  * @author Adrien RICCIARDI
  */
+#include <algorithm>
 #include <AudioManager.hpp>
 #include <BigEnemyFightingEntity.hpp>
 #include <BulletMovingEntity.hpp>
@@ -14,17 +15,30 @@
 #include <EnemySpawnerStaticEntity.hpp>
 #include <FileManager.hpp>
 #include <HeadUpDisplay.hpp>
+#include <JobManager.hpp>
 #include <list>
 #include <Log.hpp>
 #include <LevelManager.hpp>
 #include <MediumEnemyFightingEntity.hpp>
 #include <Menu.hpp>
+#include <NavigationManager.hpp>
 #include <PlayerFightingEntity.hpp>
 #include <Renderer.hpp>
+#include <ReplayManager.hpp>
 #include <SavegameManager.hpp>
 #include <SDL2/SDL.h>
+#include <SimulationClock.hpp>
 #include <SmallEnemyFightingEntity.hpp>
 #include <TextureManager.hpp>
+#include <TimerManager.hpp>
+#include <vector>
+#include <VisibilityManager.hpp>
+#ifdef _WIN32
+	#include <windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
 
 //-------------------------------------------------------------------------------------------------
 // Private variables
@@ -34,8 +48,25 @@ static std::list<BulletMovingEntity *> _playerBulletsList;
 /** All bullets shot by the enemies. */
 static std::list<BulletMovingEntity *> _enemiesBulletsList;
 
+/** A player bullet moved by the worker threads, with the information the collision checks need afterwards. */
+typedef struct
+{
+	BulletMovingEntity *pointerBullet; //!< The bullet to move.
+	int previousCenterX; //!< The bullet center X coordinate before it moved.
+	int previousCenterY; //!< The bullet center Y coordinate before it moved.
+	int updateResult; //!< The value returned by the bullet update() method.
+} MovingBullet;
+/** The player bullets copied to an array on each update, so the worker threads can directly access them. */
+static std::vector<MovingBullet> _movingPlayerBulletsArray;
+
 /** All enemies. */
 static std::list<EnemyFightingEntity *> _enemiesList;
+/** The enemies choosing their action on this update, copied to an array so the worker threads can directly access them. */
+static std::vector<EnemyFightingEntity *> _decidingEnemiesArray;
+/** The enemies not near the player but able to spot it, they choose their action in turn. */
+static std::vector<EnemyFightingEntity *> _mediumTierEnemiesArray;
+/** The enemies too far to spot the player, they look for it in turn. */
+static std::vector<EnemyFightingEntity *> _farTierEnemiesArray;
 
 /** How many pixels to subtract to the player X coordinate to obtain the scene camera X coordinate. */
 static int _cameraOffsetX;
@@ -58,6 +89,9 @@ static bool _isGamePaused = false;
 /** Set to 1 when the player has finished all levels. */
 static bool _isGameFinished = false;
 
+/** Set by a timer when the enemy spawners can spawn enemies again. */
+static bool _isEnemySpawningTimeElapsed = true; // Spawn enemies immediately when the game starts
+
 /** The string to display when the player is dead. */
 static SDL_Texture *_pointerGameLostInterfaceStringTexture;
 /** The string to display when the player won the game. */
@@ -93,21 +127,80 @@ static void _clearAllLists()
 	EffectManager::clearAllEffects();
 }
 
+/** Mix a value into a checksum (this is the FNV-1a hash function applied to the value bytes).
+ * @param checksum The checksum computed so far.
+ * @param value The value to add.
+ * @return The new checksum.
+ */
+static inline unsigned int _addToChecksum(unsigned int checksum, int value)
+{
+	for (int i = 0; i < 4; i++) checksum = (checksum ^ ((value >> (i * 8)) & 0xFF)) * 16777619;
+	return checksum;
+}
+
+/** Compute a value summarizing the game state, so two games can be compared.
+ * @return The game state checksum.
+ */
+static unsigned int _computeGameStateChecksum()
+{
+	unsigned int checksum = 2166136261u;
+	
+	checksum = _addToChecksum(checksum, SimulationClock::getTicksCount());
+	checksum = _addToChecksum(checksum, SimulationClock::getTime());
+	checksum = _addToChecksum(checksum, _currentLevelNumber);
+	
+	// Player
+	checksum = _addToChecksum(checksum, pointerPlayer->getX());
+	checksum = _addToChecksum(checksum, pointerPlayer->getY());
+	checksum = _addToChecksum(checksum, pointerPlayer->getLifePointsAmount());
+	checksum = _addToChecksum(checksum, pointerPlayer->getMaximumLifePointsAmount());
+	checksum = _addToChecksum(checksum, pointerPlayer->getAmmunitionAmount());
+	
+	// Enemies
+	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
+	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator)
+	{
+		checksum = _addToChecksum(checksum, (*enemiesListIterator)->getX());
+		checksum = _addToChecksum(checksum, (*enemiesListIterator)->getY());
+		checksum = _addToChecksum(checksum, (*enemiesListIterator)->getLifePointsAmount());
+	}
+	
+	// Enemy spawners
+	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+	for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator)
+	{
+		checksum = _addToChecksum(checksum, (*enemySpawnersListIterator)->getX());
+		checksum = _addToChecksum(checksum, (*enemySpawnersListIterator)->getY());
+	}
+	
+	// Bullets
+	checksum = _addToChecksum(checksum, _playerBulletsList.size());
+	checksum = _addToChecksum(checksum, _enemiesBulletsList.size());
+	
+	return checksum;
+}
+
 /** Automatically free allocated resources on program shutdown. */
 static void _exitFreeResources()
 {
 	// Free all cached interface strings
-	SDL_DestroyTexture(_pointerGameLostInterfaceStringTexture);
-	SDL_DestroyTexture(_pointerGameWonInterfaceStringTexture);
+	Renderer::destroyTexture(_pointerGameLostInterfaceStringTexture);
+	Renderer::destroyTexture(_pointerGameWonInterfaceStringTexture);
+	
+	// Terminate the record file with the final game state
+	if (ReplayManager::isRecording()) ReplayManager::stopRecording(_computeGameStateChecksum());
 	
 	// Delete all entities
 	_clearAllLists();
 	
 	delete pointerPlayer;
 	
+	TimerManager::uninitialize();
+	JobManager::uninitialize();
 	ControlManager::uninitialize();
 	AudioManager::uninitialize();
 	LevelManager::uninitialize();
+	Menu::uninitialize();
 	TextureManager::uninitialize();
 	Renderer::uninitialize();
 	
@@ -116,6 +209,36 @@ static void _exitFreeResources()
 	LOG_INFORMATION("Game engine successfully exited.");
 }
 
+/** Add an enemy to the game and store it in the visibility cells.
+ * @param pointerEnemy The enemy, nothing is done if it is NULL.
+ */
+static inline void _addEnemy(EnemyFightingEntity *pointerEnemy)
+{
+	if (pointerEnemy == NULL) return;
+	_enemiesList.push_front(pointerEnemy);
+	VisibilityManager::addEntity(pointerEnemy, VisibilityManager::ENTITY_TYPE_ENEMY);
+}
+
+/** Add a bullet shot by the player to the game and store it in the visibility cells.
+ * @param pointerBullet The bullet, nothing is done if it is NULL.
+ */
+static inline void _addPlayerBullet(BulletMovingEntity *pointerBullet)
+{
+	if (pointerBullet == NULL) return;
+	_playerBulletsList.push_front(pointerBullet);
+	VisibilityManager::addEntity(pointerBullet, VisibilityManager::ENTITY_TYPE_BULLET);
+}
+
+/** Add a bullet shot by an enemy to the game and store it in the visibility cells.
+ * @param pointerBullet The bullet, nothing is done if it is NULL.
+ */
+static inline void _addEnemyBullet(BulletMovingEntity *pointerBullet)
+{
+	if (pointerBullet == NULL) return;
+	_enemiesBulletsList.push_front(pointerBullet);
+	VisibilityManager::addEntity(pointerBullet, VisibilityManager::ENTITY_TYPE_BULLET);
+}
+
 /** Tell whether an enemy can be spawned on the block located at the provided map coordinates.
  * @param x X map coordinate in the block.
  * @param y Y map coordinate in the block.
@@ -134,6 +257,35 @@ int _isBlockAvailableForSpawn(int x, int y)
 	return 1;
 }
 
+/** Create a random enemy at a block center.
+ * @param x X map coordinate of the block top-left corner.
+ * @param y Y map coordinate of the block top-left corner.
+ * @return The created enemy.
+ */
+static EnemyFightingEntity *_createEnemy(int x, int y)
+{
+	int spawningPercentage;
+	EnemyFightingEntity *pointerEnemy;
+	SDL_Rect *pointerEnemyPositionRectangle;
+	
+	// Select which enemy to spawn
+	spawningPercentage = rand() % 100;
+	// Start with the smaller percentage and continue so on
+	if (spawningPercentage <= CONFIGURATION_GAMEPLAY_BIG_ENEMY_SPAWN_PROBABILITY_PERCENTAGE) pointerEnemy = new BigEnemyFightingEntity(x, y); // Spawn the enemy on the top-left part of the block, as the enemy size can't be known until it is instantiated
+	else if (spawningPercentage <= CONFIGURATION_GAMEPLAY_MEDIUM_ENEMY_SPAWN_PROBABILITY_PERCENTAGE) pointerEnemy = new MediumEnemyFightingEntity(x, y);
+	else pointerEnemy = new SmallEnemyFightingEntity(x, y);
+	
+	// Adjust coordinates to spawn the enemy at the block center
+	pointerEnemyPositionRectangle = pointerEnemy->getPositionRectangle();
+	x += (CONFIGURATION_LEVEL_BLOCK_SIZE - pointerEnemyPositionRectangle->w) / 2;
+	y += (CONFIGURATION_LEVEL_BLOCK_SIZE - pointerEnemyPositionRectangle->h) / 2;
+	pointerEnemy->setX(x);
+	pointerEnemy->setY(y);
+	
+	LOG_DEBUG("Spawned an enemy on map coordinates (%d, %d).", x, y);
+	return pointerEnemy;
+}
+
 /** Try to spawn an enemy around a spawner.
  * @param enemySpawnerX Spawner X map coordinate.
  * @param enemySpawnerY Spawner Y map coordinate.
@@ -142,9 +294,7 @@ int _isBlockAvailableForSpawn(int x, int y)
  */
 static inline EnemyFightingEntity *_spawnEnemy(int enemySpawnerX, int enemySpawnerY)
 {
-	int x, y, spawningPercentage;
-	EnemyFightingEntity *pointerEnemy;
-	SDL_Rect *pointerEnemyPositionRectangle;
+	int x, y;
 	
 	// Find a free block to spawn the enemy onto
 	// North-west block
@@ -179,22 +329,7 @@ static inline EnemyFightingEntity *_spawnEnemy(int enemySpawnerX, int enemySpawn
 	return NULL;
 	
 Spawn_Enemy:
-	// Select which enemy to spawn
-	spawningPercentage = rand() % 100;
-	// Start with the smaller percentage and continue so on
-	if (spawningPercentage <= CONFIGURATION_GAMEPLAY_BIG_ENEMY_SPAWN_PROBABILITY_PERCENTAGE) pointerEnemy = new BigEnemyFightingEntity(x, y); // Spawn the enemy on the top-left part of the block, as the enemy size can't be known until it is instantiated
-	else if (spawningPercentage <= CONFIGURATION_GAMEPLAY_MEDIUM_ENEMY_SPAWN_PROBABILITY_PERCENTAGE) pointerEnemy = new MediumEnemyFightingEntity(x, y);
-	else pointerEnemy = new SmallEnemyFightingEntity(x, y);
-	
-	// Adjust coordinates to spawn the enemy at the block center
-	pointerEnemyPositionRectangle = pointerEnemy->getPositionRectangle();
-	x += (CONFIGURATION_LEVEL_BLOCK_SIZE - pointerEnemyPositionRectangle->w) / 2;
-	y += (CONFIGURATION_LEVEL_BLOCK_SIZE - pointerEnemyPositionRectangle->h) / 2;
-	pointerEnemy->setX(x);
-	pointerEnemy->setY(y);
-	
-	LOG_DEBUG("Spawned an enemy on map coordinates (%d, %d).", x, y);
-	return pointerEnemy;
+	return _createEnemy(x, y);
 }
 
 /** Load next level. */
@@ -221,22 +356,156 @@ static inline void _loadNextLevel()
 		exit(-1);
 	}
 	
-	// Save player progress
+	// Save player progress (a simulated or replayed game must not overwrite the player savegame, but the level restarting code needs the values)
 	SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_STARTING_LEVEL, _currentLevelNumber);
 	SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_MAXIMUM_LIFE_POINTS, pointerPlayer->getMaximumLifePointsAmount());
 	SavegameManager::setSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_AMMUNITION, pointerPlayer->getAmmunitionAmount());
-	SavegameManager::storeSavegame();
-	LOG_DEBUG("Saved game.");
+	if (!Renderer::isHeadlessModeEnabled && !ReplayManager::isReplaying())
+	{
+		SavegameManager::storeSavegame();
+		LOG_DEBUG("Saved game.");
+	}
 	
 	// Prepare to load next level
 	_currentLevelNumber++;
 }
 
+/** Load the current level again and restore player state as it was when the level started. */
+static void _restartLevel()
+{
+	int levelToLoadNumber, lifePointsAmount;
+	
+	// Stop currently playing sounds
+	AudioManager::stopAllSounds();
+	
+	// Free all entities
+	_clearAllLists();
+	
+	// Choose level number to load (_loadNextLevel() automatically increments _currentLevelNumber)
+	if (_currentLevelNumber == 0) levelToLoadNumber = 0;
+	else levelToLoadNumber = _currentLevelNumber - 1;
+	
+	// Try to load the level
+	if (LevelManager::loadLevel(levelToLoadNumber) != 0)
+	{
+		LOG_ERROR("Failed to reload level %d.", levelToLoadNumber);
+		exit(-1);
+	}
+	
+	// Restore player life and ammunition count as they were at the level start
+	lifePointsAmount = SavegameManager::getSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_MAXIMUM_LIFE_POINTS);
+	pointerPlayer->setLifePointsAmount(lifePointsAmount);
+	pointerPlayer->setMaximumLifePointsAmount(lifePointsAmount);
+	pointerPlayer->setAmmunitionAmount(SavegameManager::getSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_AMMUNITION));
+	
+	// Allow the game to restart if the player is dead
+	if (_isPlayerDead)
+	{
+		_isPlayerDead = false;
+		_isGamePaused = false;
+	}
+}
+
+/** Make some enemies choose their next action (this is called by the worker threads).
+ * @param firstItemIndex The first enemy in the deciding enemies array.
+ * @param itemsCount How many enemies to process.
+ */
+static void _decideEnemiesActions(void *, int firstItemIndex, int itemsCount)
+{
+	for (int i = firstItemIndex; i < firstItemIndex + itemsCount; i++) _decidingEnemiesArray[i]->decide();
+}
+
+/** Make the enemies of an AI tier whose turn has come choose their action, the other ones repeat their previous action.
+ * @param pointerTierEnemiesArray The tier enemies.
+ * @param decisionsCount How many enemies of the tier can choose their action on this tick.
+ * @param pointerNextEnemyIndex On input, contain the index of the first enemy allowed to choose. On output, contain the index of the first enemy allowed to choose on next tick.
+ */
+static void _scheduleTierDecisions(std::vector<EnemyFightingEntity *> *pointerTierEnemiesArray, int decisionsCount, unsigned int *pointerNextEnemyIndex)
+{
+	int i, enemiesCount = pointerTierEnemiesArray->size();
+	
+	// All enemies can choose if the tier is small enough
+	if (enemiesCount <= decisionsCount)
+	{
+		_decidingEnemiesArray.insert(_decidingEnemiesArray.end(), pointerTierEnemiesArray->begin(), pointerTierEnemiesArray->end());
+		return;
+	}
+	
+	// Let the next enemies in turn choose (the tier enemies change on each tick, so the turn is only approximately fair)
+	int firstEnemyIndex = *pointerNextEnemyIndex % enemiesCount;
+	for (i = 0; i < enemiesCount; i++)
+	{
+		if ((i - firstEnemyIndex + enemiesCount) % enemiesCount < decisionsCount) _decidingEnemiesArray.push_back((*pointerTierEnemiesArray)[i]);
+		else (*pointerTierEnemiesArray)[i]->repeatDecision();
+	}
+	*pointerNextEnemyIndex = firstEnemyIndex + decisionsCount;
+}
+
+/** Choose the enemies that will decide their action on this tick according to their distance to the player, so the AI cost does not grow with the enemies count. */
+static void _selectDecidingEnemies()
+{
+	static unsigned int mediumTierNextEnemyIndex = 0, farTierNextEnemyIndex = 0;
+	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
+	SDL_Rect *pointerPositionRectangle;
+	int horizontalDistance, verticalDistance;
+	
+	// Compute the player center
+	pointerPositionRectangle = pointerPlayer->getPositionRectangle();
+	int playerCenterX = pointerPositionRectangle->x + (pointerPositionRectangle->w / 2);
+	int playerCenterY = pointerPositionRectangle->y + (pointerPositionRectangle->h / 2);
+	
+	// Sort the enemies by AI tier
+	_decidingEnemiesArray.clear();
+	_mediumTierEnemiesArray.clear();
+	_farTierEnemiesArray.clear();
+	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator)
+	{
+		pointerPositionRectangle = (*enemiesListIterator)->getPositionRectangle();
+		horizontalDistance = abs(pointerPositionRectangle->x + (pointerPositionRectangle->w / 2) - playerCenterX);
+		verticalDistance = abs(pointerPositionRectangle->y + (pointerPositionRectangle->h / 2) - playerCenterY);
+		
+		// The player can enter the enemy shooting areas soon, choose on every tick
+		if ((horizontalDistance <= (Renderer::displayWidth / 2) + CONFIGURATION_ENEMY_AI_NEAR_TIER_MARGIN) && (verticalDistance <= (Renderer::displayHeight / 2) + CONFIGURATION_ENEMY_AI_NEAR_TIER_MARGIN)) _decidingEnemiesArray.push_back(*enemiesListIterator);
+		// The player is in the enemy spotting area (which is two displays wide and high)
+		else if ((horizontalDistance < Renderer::displayWidth) && (verticalDistance < Renderer::displayHeight)) _mediumTierEnemiesArray.push_back(*enemiesListIterator);
+		else _farTierEnemiesArray.push_back(*enemiesListIterator);
+	}
+	
+	_scheduleTierDecisions(&_mediumTierEnemiesArray, CONFIGURATION_ENEMY_AI_MEDIUM_TIER_DECISIONS_PER_TICK, &mediumTierNextEnemyIndex);
+	_scheduleTierDecisions(&_farTierEnemiesArray, CONFIGURATION_ENEMY_AI_FAR_TIER_DECISIONS_PER_TICK, &farTierNextEnemyIndex);
+}
+
+/** Move some player bullets (this is called by the worker threads).
+ * @param firstItemIndex The first bullet in the moving player bullets array.
+ * @param itemsCount How many bullets to process.
+ */
+static void _movePlayerBullets(void *, int firstItemIndex, int itemsCount)
+{
+	MovingBullet *pointerMovingBullet;
+	
+	for (int i = firstItemIndex; i < firstItemIndex + itemsCount; i++)
+	{
+		pointerMovingBullet = &_movingPlayerBulletsArray[i];
+		
+		// Cache player bullet position
+		pointerMovingBullet->previousCenterX = pointerMovingBullet->pointerBullet->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET;
+		pointerMovingBullet->previousCenterY = pointerMovingBullet->pointerBullet->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET;
+		
+		pointerMovingBullet->updateResult = pointerMovingBullet->pointerBullet->update();
+	}
+}
+
+/** Tell the enemy spawners that enough time has elapsed since the last spawn.
+ * @param pointerParameter Not used.
+ */
+static void _enemySpawningTimerCallback(void *)
+{
+	_isEnemySpawningTimeElapsed = true;
+}
+
 /** Update all game actors. */
 static inline void _updateGameLogic()
 {
-	static unsigned int lastEnemySpawningTime = -CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN; // Initialize to a negative value (gcc allows it) to spawn an enemy immediately when the game starts
-	
 	// Check if pickable objects can be taken by the player or if the level end has been reached
 	if (pointerPlayer->update() == 2)
 	{
@@ -251,24 +520,42 @@ static inline void _updateGameLogic()
 		}
 	}
 	
+	// Count the enemy spawners around the block the player is now in, for the compass
+	LevelManager::setEnemySpawnersReferenceBlock(pointerPlayer->getX(), pointerPlayer->getY());
+	
+	// Move all player bullets at the same time, they can only collide with the level walls and the enemy spawners, which do not change until the enemy spawners update
+	std::list<BulletMovingEntity *>::iterator bulletsListIterator;
+	int movingBulletIndex = 0;
+	_movingPlayerBulletsArray.resize(_playerBulletsList.size());
+	for (bulletsListIterator = _playerBulletsList.begin(); bulletsListIterator != _playerBulletsList.end(); ++bulletsListIterator)
+	{
+		_movingPlayerBulletsArray[movingBulletIndex].pointerBullet = *bulletsListIterator;
+		movingBulletIndex++;
+	}
+	JobManager::parallelFor(_movingPlayerBulletsArray.size(), _movePlayerBullets, NULL);
+	
 	// Check if player bullets have hit a wall or an enemy
-	std::list<BulletMovingEntity *>::iterator bulletsListIterator = _playerBulletsList.begin();
 	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
 	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
 	BulletMovingEntity *pointerPlayerBullet;
 	EnemyFightingEntity *pointerEnemy;
 	EnemySpawnerStaticEntity *pointerEnemySpawner;
+	MovingBullet *pointerMovingBullet;
 	int soundEmitterAngle, soundEmitterDistance, playerBulletCenterX, playerBulletCenterY;
+	bulletsListIterator = _playerBulletsList.begin();
+	movingBulletIndex = 0;
 	while (bulletsListIterator != _playerBulletsList.end())
 	{
 		pointerPlayerBullet = *bulletsListIterator;
+		pointerMovingBullet = &_movingPlayerBulletsArray[movingBulletIndex];
+		movingBulletIndex++;
 		
-		// Cache player bullet position
-		playerBulletCenterX = pointerPlayerBullet->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET;
-		playerBulletCenterY = pointerPlayerBullet->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET;
+		// Get the player bullet position cached before it moved
+		playerBulletCenterX = pointerMovingBullet->previousCenterX;
+		playerBulletCenterY = pointerMovingBullet->previousCenterY;
 		
 		// Remove the bullet if it hit a wall
-		if (pointerPlayerBullet->update() != 0)
+		if (pointerMovingBullet->updateResult != 0)
 		{
 			// Display the corresponding bullet explosion effect
 			AudioManager::computePositionFromCamera(playerBulletCenterX, playerBulletCenterY, &soundEmitterAngle, &soundEmitterDistance);
@@ -332,12 +619,20 @@ static inline void _updateGameLogic()
 		// The bullet collided an enemy spawner and was destroyed, check next bullet
 		if (enemySpawnersListIterator != LevelManager::enemySpawnersList.end()) continue;
 		
-		// The bullet is still alive, check next one
+		// The bullet is still alive, move it to its new cell if needed and check next one
+		VisibilityManager::updateEntity(pointerPlayerBullet);
 		++bulletsListIterator;
 	}
 	
-	// Update enemies artificial intelligence
-	BulletMovingEntity *pointerBullet;
+	// Find the shortest paths to the player once for all enemies (the player can't move until the next tick)
+	SDL_Rect *pointerPlayerPositionRectangle = pointerPlayer->getPositionRectangle();
+	NavigationManager::updatePlayerDistances(pointerPlayerPositionRectangle->x + (pointerPlayerPositionRectangle->w / 2), pointerPlayerPositionRectangle->y + (pointerPlayerPositionRectangle->h / 2));
+	
+	// Let the enemies choose their action at the same time, their decisions only depend on the player and the level walls
+	_selectDecidingEnemies();
+	JobManager::parallelFor(_decidingEnemiesArray.size(), _decideEnemiesActions, NULL);
+	
+	// Update enemies artificial intelligence (apply the decided actions one enemy after the other, so each move sees the blocks occupied by the previously moved enemies)
 	int result;
 	int previousEnemiesAmount = _enemiesList.size();
 	SDL_Rect *pointerPositionRectangle;
@@ -364,11 +659,11 @@ static inline void _updateGameLogic()
 		else if (result == 2)
 		{
 			// Is the enemy allowed to fire ?
-			pointerBullet = pointerEnemy->shoot();
-			if (pointerBullet != NULL) _enemiesBulletsList.push_front(pointerBullet);
+			_addEnemyBullet(pointerEnemy->shoot());
 		}
 		
 		// Enemy is still alive, check next one
+		VisibilityManager::updateEntity(pointerEnemy);
 		++enemiesListIterator;
 	}
 	
@@ -386,7 +681,7 @@ static inline void _updateGameLogic()
 			EffectManager::addEffect(pointerEnemyBullet->getX() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, pointerEnemyBullet->getY() + CONFIGURATION_BULLET_EXPLOSION_POSITION_OFFSET, EffectManager::EFFECT_ID_BULLET_EXPLOSION_NO_SOUND);
 			
 			delete pointerEnemyBullet;
-			bulletsListIterator = _playerBulletsList.erase(bulletsListIterator);
+			bulletsListIterator = _enemiesBulletsList.erase(bulletsListIterator);
 			continue;
 		}
 		
@@ -400,7 +695,7 @@ static inline void _updateGameLogic()
 			
 			// Remove the bullet
 			delete pointerEnemyBullet;
-			bulletsListIterator = _playerBulletsList.erase(bulletsListIterator);
+			bulletsListIterator = _enemiesBulletsList.erase(bulletsListIterator);
 			
 			// Instantly stop game updating
 			if (pointerPlayer->isDead())
@@ -414,6 +709,7 @@ static inline void _updateGameLogic()
 		}
 		
 		// Bullet is still alive, check next one
+		VisibilityManager::updateEntity(pointerEnemyBullet);
 		++bulletsListIterator;
 	}
 	
@@ -421,9 +717,10 @@ static inline void _updateGameLogic()
 	int blockContent, isEnemySpawned = 0;
 	enemySpawnersListIterator = LevelManager::enemySpawnersList.begin();
 	// Should enemies be spawned ?
-	if (SDL_GetTicks() - lastEnemySpawningTime >= CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN)
+	if (_isEnemySpawningTimeElapsed)
 	{
-		lastEnemySpawningTime = SDL_GetTicks();
+		_isEnemySpawningTimeElapsed = false;
+		TimerManager::schedule(CONFIGURATION_GAMEPLAY_TIME_BETWEEN_ENEMY_SPAWN, _enemySpawningTimerCallback, NULL);
 		isEnemySpawned = 1;
 	}
 	while (enemySpawnersListIterator !=  LevelManager::enemySpawnersList.end())
@@ -449,8 +746,7 @@ static inline void _updateGameLogic()
 		else if (isEnemySpawned)
 		{
 			pointerPositionRectangle = pointerEnemySpawner->getPositionRectangle();
-			pointerEnemy = _spawnEnemy(pointerPositionRectangle->x, pointerPositionRectangle->y);
-			if (pointerEnemy != NULL) _enemiesList.push_front(pointerEnemy);
+			_addEnemy(_spawnEnemy(pointerPositionRectangle->x, pointerPositionRectangle->y));
 		}
 		
 		// Spawner is still working, check next one
@@ -468,30 +764,11 @@ static inline void _updateGameLogic()
 /** Display and keep up to date interface strings. */
 static inline void _renderInterface()
 {
-	// Turn off all compass arrows, so only the appropriate ones will be lighted
-	for (int i = 0; i < HeadUpDisplay::COMPASS_ARROW_IDS_COUNT; i++) HeadUpDisplay::setCompassArrowState(static_cast<HeadUpDisplay::CompassArrowId>(i), false);
-	
-	// Detect enemy spawners positions against player to light the corresponding compass arrows
-	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
-	EnemySpawnerStaticEntity *pointerSpawner;
-	int playerBlockX = pointerPlayer->getX() / CONFIGURATION_LEVEL_BLOCK_SIZE;
-	int playerBlockY = pointerPlayer->getY() / CONFIGURATION_LEVEL_BLOCK_SIZE;
-	int spawnerBlockX, spawnerBlockY;
-	for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator)
-	{
-		// Compute spawner block position
-		pointerSpawner = *enemySpawnersListIterator;
-		spawnerBlockX = pointerSpawner->getX() / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		spawnerBlockY = pointerSpawner->getY() / CONFIGURATION_LEVEL_BLOCK_SIZE;
-		
-		// Is the spawner above the player ?
-		if (spawnerBlockY < playerBlockY) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_UP, true);
-		else if (spawnerBlockY > playerBlockY) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_DOWN, true);
-		
-		// Is the spawner on the player left ?
-		if (spawnerBlockX < playerBlockX) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_LEFT, true);
-		else if (spawnerBlockX > playerBlockX) HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_RIGHT, true);
-	}
+	// Light the compass arrows pointing to the remaining enemy spawners
+	HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_UP, LevelManager::getEnemySpawnersCount(MovingEntity::DIRECTION_UP) > 0);
+	HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_DOWN, LevelManager::getEnemySpawnersCount(MovingEntity::DIRECTION_DOWN) > 0);
+	HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_LEFT, LevelManager::getEnemySpawnersCount(MovingEntity::DIRECTION_LEFT) > 0);
+	HeadUpDisplay::setCompassArrowState(HeadUpDisplay::COMPASS_ARROW_ID_RIGHT, LevelManager::getEnemySpawnersCount(MovingEntity::DIRECTION_RIGHT) > 0);
 	
 	HeadUpDisplay::render();
 	
@@ -503,45 +780,366 @@ static inline void _renderInterface()
 /** Display everything to the screen. */
 static inline void _renderGame()
 {
-	// Compute rendering top left coordinates
-	int sceneX = pointerPlayer->getX() - _cameraOffsetX;
-	int sceneY = pointerPlayer->getY() - _cameraOffsetY;
+	// Compute rendering top left coordinates (the camera follows the player displayed position, so it is interpolated too)
+	int sceneX = pointerPlayer->getInterpolatedX() - _cameraOffsetX;
+	int sceneY = pointerPlayer->getInterpolatedY() - _cameraOffsetY;
 	Renderer::displayX = sceneX;
 	Renderer::displayY = sceneY;
 	
 	// Render the level walls and static objects (ammunition, medipacks, ...)
+	Renderer::setLayer(Renderer::LAYER_ID_SCENE);
 	LevelManager::renderScene(sceneX, sceneY);
 	
-	// Display enemy spawners
-	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
-	for (enemySpawnersListIterator = LevelManager::enemySpawnersList.begin(); enemySpawnersListIterator != LevelManager::enemySpawnersList.end(); ++enemySpawnersListIterator) (*enemySpawnersListIterator)->render();
+	// Display enemy spawners (only the entities located around the display are visited)
+	Renderer::setLayer(Renderer::LAYER_ID_ENTITIES);
+	VisibilityManager::renderEntities(VisibilityManager::ENTITY_TYPE_ENEMY_SPAWNER);
 	
 	// Display enemies
-	std::list<EnemyFightingEntity *>::iterator enemiesListIterator;
-	for (enemiesListIterator = _enemiesList.begin(); enemiesListIterator != _enemiesList.end(); ++enemiesListIterator) (*enemiesListIterator)->render();
+	VisibilityManager::renderEntities(VisibilityManager::ENTITY_TYPE_ENEMY);
 	
 	// Display bullets after enemies, so when multiple enemies fire on themselves bullets are visible on top of enemies
-	std::list<BulletMovingEntity *>::iterator bulletsListIterator;
-	for (bulletsListIterator = _playerBulletsList.begin(); bulletsListIterator != _playerBulletsList.end(); ++bulletsListIterator) (*bulletsListIterator)->render();
-	for (bulletsListIterator = _enemiesBulletsList.begin(); bulletsListIterator != _enemiesBulletsList.end(); ++bulletsListIterator) (*bulletsListIterator)->render();
+	VisibilityManager::renderEntities(VisibilityManager::ENTITY_TYPE_BULLET);
 	
 	// Display the player now, so it is always rendered on top on everything else and can always be visible
+	Renderer::setLayer(Renderer::LAYER_ID_PLAYER);
 	pointerPlayer->render();
 	
 	// Display special effects at the end, so they can recover everything
+	Renderer::setLayer(Renderer::LAYER_ID_EFFECTS);
 	EffectManager::render();
 	
 	// Display the red overlay
 	if (_isPlayerHit)
 	{
-		SDL_RenderCopy(Renderer::pointerRenderer, _pointerPlayerHitOverlayTexture->getSDLTexture(), NULL, NULL);
+		Renderer::setLayer(Renderer::LAYER_ID_OVERLAY);
+		Renderer::renderTextureArea(_pointerPlayerHitOverlayTexture->getSDLTexture(), _pointerPlayerHitOverlayTexture->getSourceRectangle(), NULL);
 		_isPlayerHit = false;
 	}
 	
 	// Display HUD
+	Renderer::setLayer(Renderer::LAYER_ID_INTERFACE);
 	_renderInterface();
 }
 
+/** Close the replayed file and tell whether the replay reached the same game state than the recorded game.
+ * @return 0 if the game state is identical to the recorded one,
+ * @return -1 if the replay diverged.
+ */
+static int _finishReplay()
+{
+	unsigned int recordedChecksum = ReplayManager::stopReplay();
+	unsigned int replayedChecksum = _computeGameStateChecksum();
+	
+	if (replayedChecksum == recordedChecksum)
+	{
+		printf("Replay finished after %u ticks, the game state is identical to the recorded one.\n", SimulationClock::getTicksCount());
+		LOG_INFORMATION("Replay finished after %u ticks, game state checksum : 0x%08X.", SimulationClock::getTicksCount(), replayedChecksum);
+		return 0;
+	}
+	else
+	{
+		printf("Replay finished after %u ticks, the game state diverged from the recorded one.\n", SimulationClock::getTicksCount());
+		LOG_ERROR("Replay diverged after %u ticks, game state checksum : 0x%08X, recorded checksum : 0x%08X.", SimulationClock::getTicksCount(), replayedChecksum, recordedChecksum);
+		return -1;
+	}
+}
+
+/** Move the player and make it shoot according to the pressed keys. */
+static void _handlePlayerInputs()
+{
+	// React to player key press without depending of keyboard key repetition rate
+	// Handle both vertical and horizontal direction movement
+	if ((ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP) || ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_DOWN)) && (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT) || ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_RIGHT)))
+	{
+		// Keep trace of the last direction the player took to favor it, when this key will be released the previous direction will be favored
+		if (ControlManager::isLastPressedDirectionKeyOnVerticalAxis())
+		{
+			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP)) pointerPlayer->moveToUp();
+			else pointerPlayer->moveToDown();
+		}
+		else
+		{
+			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT)) pointerPlayer->moveToLeft();
+			else pointerPlayer->moveToRight();
+		}
+	}
+	// Handle a single key press
+	else
+	{
+		if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP)) pointerPlayer->moveToUp();
+		else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_DOWN)) pointerPlayer->moveToDown();
+		else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT)) pointerPlayer->moveToLeft();
+		else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_RIGHT)) pointerPlayer->moveToRight();
+	}
+	
+	// Fire a bullet
+	if (ControlManager::isKeyPressed(ControlManager::KEY_ID_PRIMARY_SHOOT))
+	{
+		// Is the player allowed to shoot ?
+		_addPlayerBullet(pointerPlayer->shoot());
+	}
+	// Fire a mortar shell (bullet and mortar shell can be shot in the same time)
+	if (ControlManager::isKeyPressed(ControlManager::KEY_ID_SECONDARY_SHOOT))
+	{
+		// Is the player allowed to shoot ?
+		_addPlayerBullet(pointerPlayer->shootSecondaryFire());
+	}
+}
+
+/** Update the game as fast as possible, without reading player inputs nor rendering anything, then display simulation statistics.
+ * @param ticksCount How many game updates to simulate.
+ * @return 0 if the simulation succeeded,
+ * @return -1 if the replayed game diverged from the recorded one.
+ */
+static int _runHeadlessSimulation(int ticksCount)
+{
+	int i, playerDeathsCount = 0;
+	bool isLevelRestarted, isReplayFinished = false;
+	
+	// Gameplay timings must not depend on how fast the simulation runs (a replay provides its own time steps)
+	SimulationClock::setFixedTimeStep(CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS);
+	
+	Uint64 startingPerformanceCounterValue = SDL_GetPerformanceCounter();
+	for (i = 0; i < ticksCount; i++)
+	{
+		// Feed the recorded inputs
+		if (ReplayManager::isReplaying())
+		{
+			if (ReplayManager::replayTick(&isLevelRestarted) != 0)
+			{
+				isReplayFinished = true;
+				break;
+			}
+			if (isLevelRestarted) _restartLevel();
+		}
+		
+		SimulationClock::update();
+		TimerManager::update();
+		ReplayManager::recordTick();
+		_handlePlayerInputs();
+		_updateGameLogic();
+		
+		if (_isPlayerDead)
+		{
+			playerDeathsCount++;
+			
+			// Start the level again to keep the simulation busy until the end (a replay restarts the level by itself)
+			if (!ReplayManager::isReplaying())
+			{
+				_restartLevel();
+				ReplayManager::recordLevelRestart();
+			}
+		}
+		// Nothing more to simulate
+		else if (_isGameFinished) break;
+	}
+	double elapsedSeconds = (double) (SDL_GetPerformanceCounter() - startingPerformanceCounterValue) / SDL_GetPerformanceFrequency();
+	
+	// Display statistics on the console and in the log file
+	printf("Simulated %d ticks in %.3f s (%.0f ticks per second). Player died %d times, last loaded level : %d.\n", i, elapsedSeconds, i / elapsedSeconds, playerDeathsCount, _currentLevelNumber - 1);
+	LOG_INFORMATION("Headless simulation : %d ticks in %.3f s, %d player deaths, last loaded level %d.", i, elapsedSeconds, playerDeathsCount, _currentLevelNumber - 1);
+	
+	if (isReplayFinished) return _finishReplay();
+	return 0;
+}
+
+/** Add enemies and bullets at random places of the stress test arena until the requested amounts are reached.
+ * @param enemiesCount How many enemies the arena must contain.
+ * @param bulletsCount How many bullets must be flying (half are player bullets, the other half are enemy bullets).
+ */
+static void _fillStressTestArena(int enemiesCount, int bulletsCount)
+{
+	int x, y, attemptsCount = 0;
+	MovingEntity::Direction direction;
+	
+	// Replace the killed enemies (give up after some failed attempts when the arena is crowded, more room will be available on next tick)
+	while (((int) _enemiesList.size() < enemiesCount) && (attemptsCount < 100))
+	{
+		x = (1 + (rand() % (CONFIGURATION_LEVEL_STRESS_TEST_ARENA_SIZE - 2))) * CONFIGURATION_LEVEL_BLOCK_SIZE;
+		y = (1 + (rand() % (CONFIGURATION_LEVEL_STRESS_TEST_ARENA_SIZE - 2))) * CONFIGURATION_LEVEL_BLOCK_SIZE;
+		if (_isBlockAvailableForSpawn(x, y)) _addEnemy(_createEnemy(x, y));
+		else attemptsCount++;
+	}
+	
+	// Replace the bullets that hit something, make them fly in a random direction from a block center
+	while ((int) (_playerBulletsList.size() + _enemiesBulletsList.size()) < bulletsCount)
+	{
+		x = ((1 + (rand() % (CONFIGURATION_LEVEL_STRESS_TEST_ARENA_SIZE - 2))) * CONFIGURATION_LEVEL_BLOCK_SIZE) + (CONFIGURATION_LEVEL_BLOCK_SIZE / 2);
+		y = ((1 + (rand() % (CONFIGURATION_LEVEL_STRESS_TEST_ARENA_SIZE - 2))) * CONFIGURATION_LEVEL_BLOCK_SIZE) + (CONFIGURATION_LEVEL_BLOCK_SIZE / 2);
+		if (LevelManager::getBlockContent(x, y) & LevelManager::BLOCK_CONTENT_WALL) continue;
+		direction = (MovingEntity::Direction) (rand() % MovingEntity::DIRECTIONS_COUNT);
+		
+		if (_playerBulletsList.size() <= _enemiesBulletsList.size()) _addPlayerBullet(new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_PLAYER_BULLET_FACING_UP, 6, direction, 1, 1));
+		else _addEnemyBullet(new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_SMALL_ENEMY_BULLET_FACING_UP, 6, direction, 1, 0));
+	}
+}
+
+/** Get the maximum amount of memory the program used since it started.
+ * @return The peak resident memory size in kilobytes.
+ */
+static long _getPeakMemoryUsage()
+{
+	#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS processMemoryCounters;
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &processMemoryCounters, sizeof(processMemoryCounters))) return 0;
+		return processMemoryCounters.PeakWorkingSetSize / 1024;
+	#else
+		struct rusage resourceUsage;
+		if (getrusage(RUSAGE_SELF, &resourceUsage) != 0) return 0;
+		#ifdef __APPLE__
+			return resourceUsage.ru_maxrss / 1024; // macOS reports bytes
+		#else
+			return resourceUsage.ru_maxrss; // Linux reports kilobytes
+		#endif
+	#endif
+}
+
+/** Load the engine with a generated arena full of entities, simulate it as fast as possible while the player keeps shooting all around, then display performance statistics.
+ * @param ticksCount How many game updates to simulate.
+ * @param enemySpawnersCount How many enemy spawners to place in the arena.
+ * @param enemiesCount How many enemies to keep alive.
+ * @param bulletsCount How many bullets to keep flying, not counting the ones shot by the player and the enemies.
+ */
+static void _runStressTest(int ticksCount, int enemySpawnersCount, int enemiesCount, int bulletsCount)
+{
+	int i, maximumEnemiesCount = 0, maximumBulletsCount = 0;
+	
+	// Always play the same scenario, so results can be compared between runs
+	srand(1);
+	
+	// Create the arena
+	if (LevelManager::generateArena(CONFIGURATION_LEVEL_STRESS_TEST_ARENA_SIZE, enemySpawnersCount) != 0)
+	{
+		LOG_ERROR("Failed to generate the stress test arena.");
+		exit(-1);
+	}
+	
+	// Gameplay timings must not depend on how fast the simulation runs
+	SimulationClock::setFixedTimeStep(CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS);
+	
+	// Measure each tick duration in performance counter units
+	std::vector<Uint64> ticksDurations(ticksCount);
+	Uint64 tickStartingPerformanceCounterValue, totalDuration = 0;
+	
+	for (i = 0; i < ticksCount; i++)
+	{
+		// Keep the load constant (this is not part of the measured time)
+		_fillStressTestArena(enemiesCount, bulletsCount);
+		
+		tickStartingPerformanceCounterValue = SDL_GetPerformanceCounter();
+		
+		// Make the player invincible and give it endless ammunition
+		pointerPlayer->setLifePointsAmount(pointerPlayer->getMaximumLifePointsAmount());
+		pointerPlayer->setAmmunitionAmount(CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_AMMUNITION_AMOUNT);
+		
+		// Turn around each second and shoot with all weapons as fast as possible
+		switch ((i / 60) % 4)
+		{
+			case 0:
+				pointerPlayer->turnToUp();
+				break;
+			
+			case 1:
+				pointerPlayer->turnToRight();
+				break;
+			
+			case 2:
+				pointerPlayer->turnToDown();
+				break;
+			
+			default:
+				pointerPlayer->turnToLeft();
+				break;
+		}
+		_addPlayerBullet(pointerPlayer->shoot());
+		_addPlayerBullet(pointerPlayer->shootSecondaryFire());
+		
+		SimulationClock::update();
+		TimerManager::update();
+		_updateGameLogic();
+		
+		// The player can still die when a lot of bullets hit it during the same tick, continue anyway
+		if (_isPlayerDead)
+		{
+			_isPlayerDead = false;
+			_isGamePaused = false;
+		}
+		
+		ticksDurations[i] = SDL_GetPerformanceCounter() - tickStartingPerformanceCounterValue;
+		totalDuration += ticksDurations[i];
+		
+		// Keep track of the highest load
+		if ((int) _enemiesList.size() > maximumEnemiesCount) maximumEnemiesCount = _enemiesList.size();
+		if ((int) (_playerBulletsList.size() + _enemiesBulletsList.size()) > maximumBulletsCount) maximumBulletsCount = _playerBulletsList.size() + _enemiesBulletsList.size();
+	}
+	
+	// Convert the durations to microseconds (a single tick is short enough to not overflow)
+	Uint64 performanceCounterFrequency = SDL_GetPerformanceFrequency();
+	std::sort(ticksDurations.begin(), ticksDurations.end());
+	for (i = 0; i < ticksCount; i++) ticksDurations[i] = (ticksDurations[i] * 1000000) / performanceCounterFrequency;
+	double elapsedSeconds = (double) totalDuration / performanceCounterFrequency;
+	
+	// Display statistics on the console and in the log file
+	printf("Stress test : %d ticks in %.3f s (%.0f ticks per second).\n", ticksCount, elapsedSeconds, ticksCount / elapsedSeconds);
+	printf("Tick duration : median %llu us, 90th percentile %llu us, 99th percentile %llu us, 99.9th percentile %llu us, maximum %llu us.\n", (unsigned long long) ticksDurations[(ticksCount - 1) / 2], (unsigned long long) ticksDurations[((ticksCount - 1) * 90) / 100], (unsigned long long) ticksDurations[((ticksCount - 1) * 99) / 100], (unsigned long long) ticksDurations[((ticksCount - 1) * 999) / 1000], (unsigned long long) ticksDurations[ticksCount - 1]);
+	printf("Maximum load : %d enemies, %d bullets. Remaining enemy spawners : %d. Peak memory usage : %ld KB.\n", maximumEnemiesCount, maximumBulletsCount, (int) LevelManager::enemySpawnersList.size(), _getPeakMemoryUsage());
+	printf("Game state checksum : 0x%08X (it must not change when only the engine performance is modified).\n", _computeGameStateChecksum());
+	LOG_INFORMATION("Stress test : %d ticks in %.3f s, median tick %llu us, 99th percentile tick %llu us, maximum tick %llu us, %d enemies, %d bullets, peak memory usage %ld KB.", ticksCount, elapsedSeconds, (unsigned long long) ticksDurations[(ticksCount - 1) / 2], (unsigned long long) ticksDurations[((ticksCount - 1) * 99) / 100], (unsigned long long) ticksDurations[ticksCount - 1], maximumEnemiesCount, maximumBulletsCount, _getPeakMemoryUsage());
+}
+
+/** Compare the paths to the player found by the navigation code with an exact search, in all game levels and in the stress test arena. The enemy spawners are destroyed little by little between the checks, so the clusters computed again are checked too.
+ * @param checksCount How many random player blocks to try each time the level changed.
+ * @return How many wrong blocks have been found.
+ */
+static int _runNavigationCheck(int checksCount)
+{
+	int levelNumber, i, enemySpawnersToDestroyCount, wrongBlocksCount, totalWrongBlocksCount = 0;
+	std::list<EnemySpawnerStaticEntity *>::iterator enemySpawnersListIterator;
+	EnemySpawnerStaticEntity *pointerEnemySpawner;
+	SDL_Rect *pointerPositionRectangle;
+	
+	// Always check the same player blocks, so results can be compared between runs
+	srand(1);
+	
+	// The last level number stands for the stress test arena
+	for (levelNumber = 0; levelNumber <= CONFIGURATION_LEVELS_COUNT; levelNumber++)
+	{
+		_clearAllLists();
+		if (levelNumber < CONFIGURATION_LEVELS_COUNT) i = LevelManager::loadLevel(levelNumber); // Recycle 'i' variable
+		else i = LevelManager::generateArena(CONFIGURATION_LEVEL_STRESS_TEST_ARENA_SIZE, 200);
+		if (i != 0)
+		{
+			LOG_ERROR("Failed to load the level %d to check.", levelNumber);
+			exit(-1);
+		}
+		
+		wrongBlocksCount = 0;
+		while (1)
+		{
+			wrongBlocksCount += NavigationManager::checkPlayerDistances(checksCount);
+			if (LevelManager::enemySpawnersList.empty()) break;
+			
+			// Destroy half of the remaining enemy spawners
+			enemySpawnersToDestroyCount = (LevelManager::enemySpawnersList.size() + 1) / 2;
+			for (i = 0; i < enemySpawnersToDestroyCount; i++)
+			{
+				pointerEnemySpawner = LevelManager::enemySpawnersList.front();
+				pointerPositionRectangle = pointerEnemySpawner->getPositionRectangle();
+				LevelManager::setBlockContent(pointerPositionRectangle->x, pointerPositionRectangle->y, LevelManager::getBlockContent(pointerPositionRectangle->x, pointerPositionRectangle->y) & ~LevelManager::BLOCK_CONTENT_ENEMY_SPAWNER);
+				delete pointerEnemySpawner;
+				LevelManager::enemySpawnersList.pop_front();
+			}
+		}
+		
+		if (levelNumber < CONFIGURATION_LEVELS_COUNT) printf("Navigation check : level %d, %d wrong blocks.\n", levelNumber, wrongBlocksCount);
+		else printf("Navigation check : stress test arena, %d wrong blocks.\n", wrongBlocksCount);
+		totalWrongBlocksCount += wrongBlocksCount;
+	}
+	
+	LOG_INFORMATION("Navigation check : %d wrong blocks.", totalWrongBlocksCount);
+	return totalWrongBlocksCount;
+}
+
 //-------------------------------------------------------------------------------------------------
 // Entry point
 //-------------------------------------------------------------------------------------------------
@@ -549,11 +1147,14 @@ int main(int argc, char *argv[])
 {
 	SDL_Event event;
 	unsigned int frameRateStartingTime = 0;
-	bool isFullScreenEnabled = true, isFramesPerSecondDisplayingEnabled = false;
-	int levelToLoadNumber, i, framesCount = 0;
-	BulletMovingEntity *pointerBullet;
-	SDL_Texture *pointerFramesPerSecondSdlTexture = NULL;
-	char stringFramesPerSecond[16];
+	bool isFullScreenEnabled = true, isFramesPerSecondDisplayingEnabled = false, isHeadlessModeEnabled = false, isLevelRestarted;
+	const char *pointerStringRecordFileName = NULL, *pointerStringReplayFileName = NULL;
+	ReplayManager::GameStartingState gameStartingState;
+	int i, ticksCount, framesCount = 0, headlessTicksCount = 0, stressTestEnemySpawnersCount, stressTestEnemiesCount, stressTestBulletsCount, framesPerSecondLimit = 0, renderScalePercentage = 100, navigationChecksCount = 0, startingLevelNumber = 0;
+	Renderer::VSyncMode vsyncMode = Renderer::VSYNC_MODE_ON;
+	float timeScale = 1;
+	bool isStressTestEnabled = false;
+	char stringFramesPerSecond[16] = "--"; // Provided text can't have a zero character size or it would trigger a SDL error
 	static const char *pointerStringsMainMenuWithSavegameItems[] =
 	{
 		"Continue game",
@@ -595,15 +1196,134 @@ int main(int argc, char *argv[])
 			}
 			// Is full screen mode requested ?
 			else if (strcmp("--windowed", argv[i]) == 0) isFullScreenEnabled = false;
+			// Limit the displayed frames rate
+			else if (strcmp("--fps-limit", argv[i]) == 0)
+			{
+				// The frames count must follow
+				if ((i + 1 >= argc) || (sscanf(argv[i + 1], "%d", &framesPerSecondLimit) != 1) || (framesPerSecondLimit < 0))
+				{
+					printf("Error : --fps-limit option needs a positive frames count (0 disables the limit).\n");
+					return EXIT_FAILURE;
+				}
+				i++;
+			}
+			// Make the game run slower or faster than real time
+			else if (strcmp("--time-scale", argv[i]) == 0)
+			{
+				// The factor must follow
+				if ((i + 1 >= argc) || (sscanf(argv[i + 1], "%f", &timeScale) != 1) || (timeScale <= 0))
+				{
+					printf("Error : --time-scale option needs a positive factor.\n");
+					return EXIT_FAILURE;
+				}
+				i++;
+			}
+			// Lower the game world resolution
+			else if (strcmp("--render-scale", argv[i]) == 0)
+			{
+				// The percentage must follow
+				if ((i + 1 < argc) && (strcmp("auto", argv[i + 1]) == 0)) renderScalePercentage = 0;
+				else if ((i + 1 >= argc) || (sscanf(argv[i + 1], "%d", &renderScalePercentage) != 1) || (renderScalePercentage < 1) || (renderScalePercentage > 100))
+				{
+					printf("Error : --render-scale option needs a percentage from 1 to 100 or \"auto\".\n");
+					return EXIT_FAILURE;
+				}
+				i++;
+			}
+			// Select how frames are synchronized with the display refresh
+			else if (strcmp("--vsync", argv[i]) == 0)
+			{
+				// The mode must follow
+				if ((i + 1 < argc) && (strcmp("on", argv[i + 1]) == 0)) vsyncMode = Renderer::VSYNC_MODE_ON;
+				else if ((i + 1 < argc) && (strcmp("off", argv[i + 1]) == 0)) vsyncMode = Renderer::VSYNC_MODE_OFF;
+				else if ((i + 1 < argc) && (strcmp("adaptive", argv[i + 1]) == 0)) vsyncMode = Renderer::VSYNC_MODE_ADAPTIVE;
+				else
+				{
+					printf("Error : --vsync option needs a mode among \"on\", \"off\" and \"adaptive\".\n");
+					return EXIT_FAILURE;
+				}
+				i++;
+			}
+			// Simulate the game without display nor sound
+			else if (strcmp("--headless", argv[i]) == 0)
+			{
+				// The ticks count must follow
+				if ((i + 1 >= argc) || (sscanf(argv[i + 1], "%d", &headlessTicksCount) != 1) || (headlessTicksCount <= 0))
+				{
+					printf("Error : --headless option needs a positive ticks count.\n");
+					return EXIT_FAILURE;
+				}
+				i++;
+				isHeadlessModeEnabled = true;
+			}
+			// Load the engine with lots of entities
+			else if (strcmp("--stress", argv[i]) == 0)
+			{
+				// All amounts must follow
+				if ((i + 4 >= argc) || (sscanf(argv[i + 1], "%d", &headlessTicksCount) != 1) || (headlessTicksCount <= 0) || (sscanf(argv[i + 2], "%d", &stressTestEnemySpawnersCount) != 1) || (stressTestEnemySpawnersCount < 0) || (sscanf(argv[i + 3], "%d", &stressTestEnemiesCount) != 1) || (stressTestEnemiesCount < 0) || (sscanf(argv[i + 4], "%d", &stressTestBulletsCount) != 1) || (stressTestBulletsCount < 0))
+				{
+					printf("Error : --stress option needs a positive ticks count followed by the enemy spawners, enemies and bullets amounts.\n");
+					return EXIT_FAILURE;
+				}
+				i += 4;
+				isHeadlessModeEnabled = true; // Nothing is displayed to measure the game logic only
+				isStressTestEnabled = true;
+			}
+			// Compare the paths to the player with an exact search
+			else if (strcmp("--check-navigation", argv[i]) == 0)
+			{
+				// The checks count must follow
+				if ((i + 1 >= argc) || (sscanf(argv[i + 1], "%d", &navigationChecksCount) != 1) || (navigationChecksCount <= 0))
+				{
+					printf("Error : --check-navigation option needs a positive checks count.\n");
+					return EXIT_FAILURE;
+				}
+				i++;
+				isHeadlessModeEnabled = true; // Nothing needs to be displayed
+			}
+			// Start a new game at another level than the first one
+			else if (strcmp("--level", argv[i]) == 0)
+			{
+				// The level number must follow
+				if ((i + 1 >= argc) || (sscanf(argv[i + 1], "%d", &startingLevelNumber) != 1) || (startingLevelNumber < 0) || (startingLevelNumber >= CONFIGURATION_LEVELS_COUNT))
+				{
+					printf("Error : --level option needs a level number from 0 to %d.\n", CONFIGURATION_LEVELS_COUNT - 1);
+					return EXIT_FAILURE;
+				}
+				i++;
+			}
+			// Record or replay the player inputs
+			else if ((strcmp("--record", argv[i]) == 0) || (strcmp("--replay", argv[i]) == 0))
+			{
+				// The file name must follow
+				if (i + 1 >= argc)
+				{
+					printf("Error : %s option needs a file name.\n", argv[i]);
+					return EXIT_FAILURE;
+				}
+				if (strcmp("--record", argv[i]) == 0) pointerStringRecordFileName = argv[i + 1];
+				else pointerStringReplayFileName = argv[i + 1];
+				i++;
+			}
 			// Display help only if requested, because macOS may add custom parameters like -psn_0_340051
 			else if ((strcmp("--help", argv[i]) == 0) || (strcmp("-h", argv[i]) == 0))
 			{
 				printf("Usage : %s [option].\n"
 					"Available options :\n"
-					"  --fps      : display frames per second count.\n"
-					"  --help,-h  : display this help and exit.\n"
-					"  --version  : display the game version and exit.\n"
-					"  --windowed : play game in windowed screen mode.\n"
+					"  --check-navigation <checks> : compare the paths to the player with an exact search for the specified random player blocks count, in all levels and in the stress test arena, then exit (the exit status tells whether all paths are right).\n"
+					"  --fps              : display frames per second count.\n"
+					"  --fps-limit <frames> : display at most the specified frames count per second (0 means no limit, which is the default).\n"
+					"  --headless <ticks> : simulate a new game for the specified ticks count as fast as possible, without display nor sound, then exit.\n"
+					"  --help,-h          : display this help and exit.\n"
+					"  --level <number>   : start a new game at the specified level, 0 is the first one (a continued or replayed game starts at its own level).\n"
+					"  --record <file>    : record the player inputs of the played game to the specified file.\n"
+					"  --render-scale <percentage> : draw the game world at the specified percentage of the display resolution (100 is the default), or at an automatically lowered resolution when frames miss the display refresh if \"auto\" is specified. The interface is always drawn at the display resolution.\n"
+					"  --replay <file>    : replay a game recorded with --record (it can be combined with --headless).\n"
+					"  --stress <ticks> <spawners> <enemies> <bullets> : simulate an arena containing the specified amounts of entities for the specified ticks count, without display nor sound, then display performance statistics and exit.\n"
+					"  --time-scale <factor> : make the game time flow slower (factor less than 1) or faster (factor more than 1) than real time, 1 is the default. This does not change the headless simulations.\n"
+					"  --version          : display the game version and exit.\n"
+					"  --vsync <mode>     : synchronize the displayed frames with the display refresh, mode can be \"on\" (default), \"off\" or \"adaptive\".\n"
+					"  --windowed         : play game in windowed screen mode.\n"
 					"All other parameters are ignored.\n", argv[0]);
 				return EXIT_SUCCESS;
 			}
@@ -612,24 +1332,42 @@ int main(int argc, char *argv[])
 		}
 	}
 	
+	// A game can't be recorded while another one is replayed, and the stress test is not a real game
+	if ((pointerStringRecordFileName != NULL) && (pointerStringReplayFileName != NULL))
+	{
+		printf("Error : --record and --replay options can't be used together.\n");
+		return EXIT_FAILURE;
+	}
+	if ((isStressTestEnabled || (navigationChecksCount > 0)) && ((pointerStringRecordFileName != NULL) || (pointerStringReplayFileName != NULL)))
+	{
+		printf("Error : --stress and --check-navigation options can't be used with --record or --replay options.\n");
+		return EXIT_FAILURE;
+	}
+	
 	// Initialize logging system as soon as possible
 	if (FileManager::initialize() != 0) return -1; // Must be initialized before the subsystems that use it
 	if (Log::initialize() != 0) return -1;
 	
 	// Initialize the needed SDL subsystems
-	if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMECONTROLLER | SDL_INIT_AUDIO) != 0)
+	if (isHeadlessModeEnabled) i = SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS); // Recycle 'i' variable
+	else i = SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMECONTROLLER | SDL_INIT_AUDIO);
+	if (i != 0)
 	{
 		LOG_ERROR("SDL_Init() failed (%s).", SDL_GetError());
 		return -1;
 	}
 	
 	// Engine initialization
-	if (Renderer::initialize(isFullScreenEnabled) != 0) return -1;
+	if (JobManager::initialize() != 0) return -1; // Must be initialized before the subsystems that submit jobs
+	if (Renderer::initialize(isFullScreenEnabled, isHeadlessModeEnabled, vsyncMode, framesPerSecondLimit, renderScalePercentage) != 0) return -1;
 	if (TextureManager::initialize() != 0) return -1;
 	if (LevelManager::initialize() != 0) return -1;
-	if (AudioManager::initialize() != 0) return -1;
+	if (AudioManager::initialize(!isHeadlessModeEnabled) != 0) return -1;
 	if (ControlManager::initialize() != 0) return -1;
 	if (HeadUpDisplay::initialize() != 0) return -1;
+	if (SimulationClock::initialize() != 0) return -1;
+	SimulationClock::setScale(timeScale);
+	if (TimerManager::initialize() != 0) return -1; // Must be initialized after the simulation clock
 	
 	// Create the player now that everything is working
 	pointerPlayer = new PlayerFightingEntity(0, 0); // It will be placed at the right location by the level loading function
@@ -637,9 +1375,6 @@ int main(int argc, char *argv[])
 	// Automatically dispose of allocated resources on program exit (allowing to use exit() elsewhere in the program)
 	atexit(_exitFreeResources);
 	
-	// Initialize pseudo-random numbers generator
-	srand(time(NULL));
-	
 	// Cache some values
 	// Offset to subtract to the player position to have the scene camera coordinates
 	_cameraOffsetX = (Renderer::displayWidth / 2) - (TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_UP)->getWidth() / 2);
@@ -652,10 +1387,22 @@ int main(int argc, char *argv[])
 	
 	LOG_INFORMATION("Game engine successfully initialized.");
 	
-	// Display the main menu and get user choice
-	bool isMainMenuDisplayed = true;
+	// Start the game as it was recorded
+	_currentLevelNumber = startingLevelNumber;
+	if (pointerStringReplayFileName != NULL)
+	{
+		if (ReplayManager::startReplay(pointerStringReplayFileName, &gameStartingState) != 0) return -1;
+		
+		_currentLevelNumber = gameStartingState.startingLevelNumber;
+		pointerPlayer->setLifePointsAmount(gameStartingState.playerMaximumLifePointsAmount);
+		pointerPlayer->setMaximumLifePointsAmount(gameStartingState.playerMaximumLifePointsAmount);
+		pointerPlayer->setAmmunitionAmount(gameStartingState.playerAmmunitionAmount);
+	}
+	
+	// Display the main menu and get user choice (there is no menu in headless mode or when a replay is played, a game is directly started)
+	bool isMainMenuDisplayed = !isHeadlessModeEnabled && (pointerStringReplayFileName == NULL);
 	bool isSavegamePresent = SavegameManager::isSavegamePresent(); // Cache value to avoid checking for the file every time the menu is displayed
-	do
+	while (isMainMenuDisplayed)
 	{
 		if (isSavegamePresent)
 		{
@@ -713,17 +1460,50 @@ int main(int argc, char *argv[])
 					goto Exit;
 			}
 		}
-	} while (isMainMenuDisplayed);
+	}
+	
+	// Initialize pseudo-random numbers generator (a replay must use the same numbers than the recorded game)
+	if (pointerStringReplayFileName == NULL) gameStartingState.randomSeed = time(NULL);
+	srand(gameStartingState.randomSeed);
+	
+	// The stress test does not use the game levels
+	if (isStressTestEnabled)
+	{
+		_runStressTest(headlessTicksCount, stressTestEnemySpawnersCount, stressTestEnemiesCount, stressTestBulletsCount);
+		return EXIT_SUCCESS;
+	}
+	if (navigationChecksCount > 0)
+	{
+		if (_runNavigationCheck(navigationChecksCount) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+	
+	// Store everything needed to start the replay like the game is starting now
+	if (pointerStringRecordFileName != NULL)
+	{
+		gameStartingState.startingLevelNumber = _currentLevelNumber;
+		gameStartingState.playerMaximumLifePointsAmount = pointerPlayer->getMaximumLifePointsAmount();
+		gameStartingState.playerAmmunitionAmount = pointerPlayer->getAmmunitionAmount();
+		if (ReplayManager::startRecording(pointerStringRecordFileName, &gameStartingState) != 0) return -1;
+	}
 	
 	// Load first level
 	_loadNextLevel();
-	AudioManager::playMusic();
 	
-	// Create a fake texture to be used by the FPS displaying code, this avoids multiple checks to detect whether the first texture is null
-	if (isFramesPerSecondDisplayingEnabled) pointerFramesPerSecondSdlTexture = Renderer::renderTextToTexture("--", Renderer::TEXT_COLOR_ID_RED, Renderer::FONT_SIZE_ID_BIG); // Provided text can't have a zero character size or it would trigger a SDL error
+	if (isHeadlessModeEnabled)
+	{
+		if (_runHeadlessSimulation(headlessTicksCount) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+	AudioManager::playMusic();
+	SimulationClock::setFixedTimeStep(CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS); // Ticks are run at a fixed rate, the real time only tells how many ticks to run
+	SimulationClock::resume(); // Do not count the time spent in the main menu
 	
 	while (1)
 	{
+		// Nothing moves while the game is stopped (the player is dead or all levels are completed), so do not draw the same frame again until the player presses a key (a replay must keep running its ticks to reach the recorded level restart)
+		if (_isGamePaused && !ReplayManager::isReplaying() && (SDL_WaitEventTimeout(NULL, CONFIGURATION_MENU_EVENTS_WAITING_TIMEOUT) == 0)) continue;
+		
 		Renderer::beginFrame();
 		
 		// Store the time when the loop started
@@ -750,6 +1530,11 @@ int main(int argc, char *argv[])
 				case SDL_KEYDOWN:
 					ControlManager::handleKeyboardEvent(&event);
 					break;
+					
+				// Some rendering drivers lose the textures drawn to when the window is resized or when the display mode changes
+				case SDL_RENDER_TARGETS_RESET:
+					HeadUpDisplay::setPanelRedrawNeeded();
+					break;
 			}
 		}
 		
@@ -759,6 +1544,7 @@ int main(int argc, char *argv[])
 			// Stop playing music while the game is paused (in case the game must be quickly hidden to an incoming person)
 			LOG_DEBUG("Game paused.");
 			AudioManager::pauseMusic(1);
+			SimulationClock::pause();
 			
 			// Player won, display a specific menu
 			if (_isGameFinished)
@@ -776,35 +1562,8 @@ int main(int argc, char *argv[])
 					
 					// Player has selected "Restart level"
 					case 1:
-						// Stop currently playing sounds
-						AudioManager::stopAllSounds();
-						
-						// Free all entities
-						_clearAllLists();
-						
-						// Choose level number to load (_loadNextLevel() automatically increments _currentLevelNumber)
-						if (_currentLevelNumber == 0) levelToLoadNumber = 0;
-						else levelToLoadNumber = _currentLevelNumber - 1;
-						
-						// Try to load the level
-						if (LevelManager::loadLevel(levelToLoadNumber) != 0)
-						{
-							LOG_ERROR("Failed to reload level %d.", levelToLoadNumber);
-							exit(-1);
-						}
-						
-						// Restore player life and ammunition count as they were at the level start
-						i = SavegameManager::getSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_MAXIMUM_LIFE_POINTS); // Recycle 'i' variable
-						pointerPlayer->setLifePointsAmount(i);
-						pointerPlayer->setMaximumLifePointsAmount(i);
-						pointerPlayer->setAmmunitionAmount(SavegameManager::getSavegameItem(SavegameManager::SAVEGAME_ITEM_ID_PLAYER_AMMUNITION));
-						
-						// Allow the game to restart if the player is dead
-						if (_isPlayerDead)
-						{
-							_isPlayerDead = false;
-							_isGamePaused = false;
-						}
+						_restartLevel();
+						ReplayManager::recordLevelRestart();
 						break;
 					
 					default:
@@ -814,54 +1573,40 @@ int main(int argc, char *argv[])
 			
 			LOG_DEBUG("Game continuing.");
 			AudioManager::pauseMusic(0);
+			SimulationClock::resume();
 		}
 		
-		// Do not update the game anymore if the player died
-		if (!_isGamePaused)
+		// Run as many game ticks as the real elapsed time contains, so the game speed does not depend on the display refresh rate
+		ticksCount = SimulationClock::getElapsedTicksCount();
+		for (i = 0; i < ticksCount; i++)
 		{
-			// React to player key press without depending of keyboard key repetition rate
-			// Handle both vertical and horizontal direction movement
-			if ((ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP) || ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_DOWN)) && (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT) || ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_RIGHT)))
+			// Feed the recorded inputs (they replace the keys pressed by the player, except the pause one)
+			if (ReplayManager::isReplaying())
 			{
-				// Keep trace of the last direction the player took to favor it, when this key will be released the previous direction will be favored
-				if (ControlManager::isLastPressedDirectionKeyOnVerticalAxis())
+				if (ReplayManager::replayTick(&isLevelRestarted) != 0)
 				{
-					if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP)) pointerPlayer->moveToUp();
-					else pointerPlayer->moveToDown();
-				}
-				else
-				{
-					if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT)) pointerPlayer->moveToLeft();
-					else pointerPlayer->moveToRight();
+					if (_finishReplay() != 0) return EXIT_FAILURE;
+					goto Exit;
 				}
-			}
-			// Handle a single key press
-			else
-			{
-				if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP)) pointerPlayer->moveToUp();
-				else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_DOWN)) pointerPlayer->moveToDown();
-				else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_LEFT)) pointerPlayer->moveToLeft();
-				else if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_RIGHT)) pointerPlayer->moveToRight();
+				if (isLevelRestarted) _restartLevel();
 			}
 			
-			// Fire a bullet
-			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_PRIMARY_SHOOT))
-			{
-				// Is the player allowed to shoot ?
-				pointerBullet = pointerPlayer->shoot();
-				if (pointerBullet != NULL) _playerBulletsList.push_front(pointerBullet);
-			}
-			// Fire a mortar shell (bullet and mortar shell can be shot in the same time)
-			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_SECONDARY_SHOOT))
+			// Do not update the game anymore if the player died
+			if (!_isGamePaused)
 			{
-				// Is the player allowed to shoot ?
-				pointerBullet = pointerPlayer->shootSecondaryFire();
-				if (pointerBullet != NULL) _playerBulletsList.push_front(pointerBullet);
+				// Advance the time seen by all gameplay subsystems
+				SimulationClock::update();
+				TimerManager::update();
+				ReplayManager::recordTick();
+				
+				_handlePlayerInputs();
+				_updateGameLogic();
 			}
-			
-			_updateGameLogic();
 		}
 		
+		// Display the moving entities between their previous and current positions, or at their last position if the game is stopped
+		if (_isGamePaused) Renderer::interpolationFactor = 1;
+		else Renderer::interpolationFactor = SimulationClock::getInterpolationFactor();
 		_renderGame();
 		
 		// Append the FPS string before displaying the rendered frame
@@ -871,9 +1616,7 @@ int main(int argc, char *argv[])
 			if (SDL_GetTicks() - frameRateStartingTime >= 1000)
 			{
 				// Render the FPS count to a string
-				SDL_DestroyTexture(pointerFramesPerSecondSdlTexture); // Free previously created texture
 				snprintf(stringFramesPerSecond, sizeof(stringFramesPerSecond), "%d", framesCount);
-				pointerFramesPerSecondSdlTexture = Renderer::renderTextToTexture(stringFramesPerSecond, Renderer::TEXT_COLOR_ID_RED, Renderer::FONT_SIZE_ID_BIG);
 				
 				// Restart computation
 				framesCount = 0;
@@ -882,7 +1625,7 @@ int main(int argc, char *argv[])
 			else framesCount++;
 			
 			// Display the FPS count to the screen top right side at each frame
-			Renderer::renderTexture(pointerFramesPerSecondSdlTexture, Renderer::displayWidth - 100, 20);
+			Renderer::renderText(stringFramesPerSecond, Renderer::TEXT_COLOR_ID_RED, Renderer::FONT_SIZE_ID_BIG, Renderer::displayWidth - 100, 20);
 		}
 		
 		Renderer::endFrame();
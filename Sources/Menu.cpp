@@ -7,9 +7,11 @@
 #include <Configuration.hpp>
 #include <ControlManager.hpp>
 #include <Log.hpp>
+#include <map>
 #include <Menu.hpp>
 #include <Renderer.hpp>
 #include <SDL2/SDL.h>
+#include <string>
 #include <TextureManager.hpp>
 
 namespace Menu
@@ -23,121 +25,172 @@ namespace Menu
 		int y; //!< Drawing Y coordinate.
 	} MenuItem;
 
-	/** All items to display. */
-	static MenuItem _menuItems[CONFIGURATION_MENU_MAXIMUM_ITEMS_COUNT];
-	/** How many items to display. */
-	static int _menuItemsCount;
+	/** All textures and coordinates needed to display a menu. */
+	typedef struct
+	{
+		SDL_Texture *pointerTitleTexture; //!< The menu title texture to render.
+		int titleTextureX; //!< Horizontal coordinate to render the title texture at the screen center.
+		MenuItem items[CONFIGURATION_MENU_MAXIMUM_ITEMS_COUNT]; //!< All items to display.
+		int itemsCount; //!< How many items to display.
+	} CachedMenu;
 
-	/** The menu title texture to render. */
-	static SDL_Texture *_pointerMenuTitleTexture;
-	/** Horizontal coordinate to render the texture at the screen center. */
-	static int _menuTitleTextureX;
+	/** All menus that have been displayed, their strings are rendered only the first time they are displayed. The key is made of the menu title and items strings. */
+	static std::map<std::string, CachedMenu> _cachedMenus;
 
-	/** Render all strings to cached textures to avoid rendering them on each frame.
+	/** Render all strings of a menu to textures, or get them from the cache if the menu has already been displayed.
 	* @param pointerStringMenuTitle The menu title.
 	* @param pointerStringsMenuItemsTexts The menu items.
+	* @param menuItemsCount How many menu items to display.
+	* @return The menu textures and coordinates.
 	*/
-	static inline void _initialize(const char *pointerStringMenuTitle, const char *pointerStringsMenuItemsTexts[])
+	static CachedMenu *_getMenu(const char *pointerStringMenuTitle, const char *pointerStringsMenuItemsTexts[], int menuItemsCount)
 	{
 		// Make sure there are not too many items
-		assert(_menuItemsCount <= CONFIGURATION_MENU_MAXIMUM_ITEMS_COUNT);
+		assert(menuItemsCount <= CONFIGURATION_MENU_MAXIMUM_ITEMS_COUNT);
+		
+		// Was this menu already displayed ?
+		std::string key = pointerStringMenuTitle;
+		int i;
+		for (i = 0; i < menuItemsCount; i++)
+		{
+			key += '\n';
+			key += pointerStringsMenuItemsTexts[i];
+		}
+		std::map<std::string, CachedMenu>::iterator cachedMenusIterator = _cachedMenus.find(key);
+		if (cachedMenusIterator != _cachedMenus.end()) return &cachedMenusIterator->second;
+		
+		CachedMenu *pointerMenu = &_cachedMenus[key];
+		pointerMenu->itemsCount = menuItemsCount;
 		
 		// Handle title texture separately because it is not a menu item (it can't be selected or focused)
 		// Render texture
-		_pointerMenuTitleTexture = Renderer::renderTextToTexture(pointerStringMenuTitle, Renderer::TEXT_COLOR_ID_BLACK, Renderer::FONT_SIZE_ID_BIG);
+		pointerMenu->pointerTitleTexture = Renderer::renderTextToTexture(pointerStringMenuTitle, Renderer::TEXT_COLOR_ID_BLACK, Renderer::FONT_SIZE_ID_BIG);
 		// Get texture size
 		int textureWidth, textureHeight;
-		if (SDL_QueryTexture(_pointerMenuTitleTexture, NULL, NULL, &textureWidth, &textureHeight) != 0)
+		if (SDL_QueryTexture(pointerMenu->pointerTitleTexture, NULL, NULL, &textureWidth, &textureHeight) != 0)
 		{
 			LOG_ERROR("Failed to query menu title texture information for texture (%s).", SDL_GetError());
 			exit(-1);
 		}
 		// Compute X coordinate to center the texture
-		_menuTitleTextureX = (Renderer::displayWidth - textureWidth) / 2;
+		pointerMenu->titleTextureX = (Renderer::displayWidth - textureWidth) / 2;
 		
 		// Handle menu items
-		int i;
-		for (i = 0; i < _menuItemsCount; i++)
+		MenuItem *pointerItems = pointerMenu->items;
+		for (i = 0; i < menuItemsCount; i++)
 		{
 			// Render strings
-			_menuItems[i].pointerNormalTexture = Renderer::renderTextToTexture(pointerStringsMenuItemsTexts[i], Renderer::TEXT_COLOR_DARK_GREY, Renderer::FONT_SIZE_ID_BIG);
-			_menuItems[i].pointerFocusedTexture = Renderer::renderTextToTexture(pointerStringsMenuItemsTexts[i], Renderer::TEXT_COLOR_LIGHT_GREY, Renderer::FONT_SIZE_ID_BIG);
+			pointerItems[i].pointerNormalTexture = Renderer::renderTextToTexture(pointerStringsMenuItemsTexts[i], Renderer::TEXT_COLOR_DARK_GREY, Renderer::FONT_SIZE_ID_BIG);
+			pointerItems[i].pointerFocusedTexture = Renderer::renderTextToTexture(pointerStringsMenuItemsTexts[i], Renderer::TEXT_COLOR_LIGHT_GREY, Renderer::FONT_SIZE_ID_BIG);
 			
 			// Compute displaying coordinates
 			// Get texture size (texture have same size because only color changes between normal and focused textures, so use the normal one)
-			if (SDL_QueryTexture(_menuItems[i].pointerNormalTexture, NULL, NULL, &textureWidth, &textureHeight) != 0)
+			if (SDL_QueryTexture(pointerItems[i].pointerNormalTexture, NULL, NULL, &textureWidth, &textureHeight) != 0)
 			{
 				LOG_ERROR("Failed to query texture information for texture %d (%s).", i, SDL_GetError());
 				exit(-1);
 			}
 			
 			// Compute X coordinate to center the texture
-			_menuItems[i].x = (Renderer::displayWidth - textureWidth) / 2;
+			pointerItems[i].x = (Renderer::displayWidth - textureWidth) / 2;
 			
 			// Each string is vertically spaced from the other ones by a fixed amount of pixels
-			_menuItems[i].y = i * CONFIGURATION_MENU_ITEM_STRINGS_VERTICAL_SPACING;
+			pointerItems[i].y = i * CONFIGURATION_MENU_ITEM_STRINGS_VERTICAL_SPACING;
 		}
 		
 		// Total vertical size of all string textures is the amount of strings * vertical spacing + the last texture height (because it is displayed starting from the last vertical spacing)
-		int stringTexturesVerticalHeight = (_menuItemsCount * CONFIGURATION_MENU_ITEM_STRINGS_VERTICAL_SPACING) + textureHeight; // The textureHeight variable contains the last texture height
+		int stringTexturesVerticalHeight = (menuItemsCount * CONFIGURATION_MENU_ITEM_STRINGS_VERTICAL_SPACING) + textureHeight; // The textureHeight variable contains the last texture height
 		int firstStringTextureY = (Renderer::displayHeight - stringTexturesVerticalHeight) / 2;
 
 		// Add Y offset to all texture coordinates, preserving the yet existing spacing
-		for (i = 0; i < _menuItemsCount; i++) _menuItems[i].y += firstStringTextureY;
+		for (i = 0; i < menuItemsCount; i++) pointerItems[i].y += firstStringTextureY;
+		
+		LOG_DEBUG("Cached menu \"%s\" textures.", pointerStringMenuTitle);
+		return pointerMenu;
 	}
 
-	/** Free all textures. */
-	static inline void _uninitialize()
+	/** Sleep until events are received, then give them to the control manager. Nothing is drawn meanwhile, so an idle menu does not use the processor nor the graphics card.
+	* @param pointerIsRedrawNeeded On output, set to true if the window content must be drawn again (it is left unchanged otherwise).
+	* @return 0 if the menu can continue,
+	* @return -1 if the user pressed Alt+F4 or closed the window.
+	*/
+	static int _waitForEvents(bool *pointerIsRedrawNeeded)
 	{
-		// Free all textures
-		SDL_DestroyTexture(_pointerMenuTitleTexture);
-		for (int i = 0; i < _menuItemsCount; i++)
+		SDL_Event event;
+		
+		// Wake up from time to time even if nothing happens, in case an event is missed
+		if (!SDL_WaitEventTimeout(&event, CONFIGURATION_MENU_EVENTS_WAITING_TIMEOUT)) return 0;
+		
+		// Process this event and all following pending ones
+		do
 		{
-			SDL_DestroyTexture(_menuItems[i].pointerNormalTexture);
-			SDL_DestroyTexture(_menuItems[i].pointerFocusedTexture);
-		}
+			switch (event.type)
+			{
+				// User closed the game window or pressed alt+F4
+				case SDL_QUIT:
+					LOG_DEBUG("Quitting game.");
+					return -1;
+					
+				case SDL_CONTROLLERBUTTONUP:
+				case SDL_CONTROLLERBUTTONDOWN:
+				case SDL_CONTROLLERAXISMOTION:
+					ControlManager::handleGameControllerEvent(&event);
+					break;
+						
+				case SDL_KEYUP:
+				case SDL_KEYDOWN:
+					ControlManager::handleKeyboardEvent(&event);
+					break;
+					
+				// The window may have been shown again or resized, its content must be restored
+				case SDL_WINDOWEVENT:
+					*pointerIsRedrawNeeded = true;
+					break;
+			}
+		} while (SDL_PollEvent(&event));
+		
+		return 0;
 	}
 
 	int display(const char *pointerStringMenuTitle, const char *pointerStringsMenuItemsTexts[], int menuItemsCount)
 	{
-		SDL_Event event;
-		int returnValue, i, focusedMenuItemIndex = 0, isGoUpKeyPressed = 0, isGoDownKeyPressed = 0, isSelectKeyPressed = 0;
+		int i, focusedMenuItemIndex = 0, isGoUpKeyPressed = 0, isGoDownKeyPressed = 0, isSelectKeyPressed = 0;
+		bool isRedrawNeeded = true;
 		SDL_Texture *pointerTexture;
 		
-		// This variable is shared by all internal functions, it must be initialized before calling any of the functions
-		_menuItemsCount = menuItemsCount;
-		
-		// Cache textures to display
-		_initialize(pointerStringMenuTitle, pointerStringsMenuItemsTexts);
+		// Get textures to display
+		CachedMenu *pointerMenu = _getMenu(pointerStringMenuTitle, pointerStringsMenuItemsTexts, menuItemsCount);
+		Texture *pointerBackgroundTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_MENU_BACKGROUND);
 		
 		while (1)
 		{
-			Renderer::beginFrame();
-			
-			// Process SDL events
-			while (SDL_PollEvent(&event))
+			// Display menu only when its content changed
+			if (isRedrawNeeded)
 			{
-				switch (event.type)
+				Renderer::beginFrame();
+				
+				// Display stretched background (so it can fit any screen resolution)
+				Renderer::renderTextureArea(pointerBackgroundTexture->getSDLTexture(), pointerBackgroundTexture->getSourceRectangle(), NULL);
+				// Display title
+				Renderer::setLayer(Renderer::LAYER_ID_INTERFACE);
+				Renderer::renderTexture(pointerMenu->pointerTitleTexture, pointerMenu->titleTextureX, CONFIGURATION_MENU_TITLE_Y);
+				// Display items
+				for (i = 0; i < pointerMenu->itemsCount; i++)
 				{
-					// User closed the game window or pressed alt+F4
-					case SDL_QUIT:
-						returnValue = -1;
-						LOG_DEBUG("Quitting game.");
-						goto Exit;
-						
-					case SDL_CONTROLLERBUTTONUP:
-					case SDL_CONTROLLERBUTTONDOWN:
-					case SDL_CONTROLLERAXISMOTION:
-						ControlManager::handleGameControllerEvent(&event);
-						break;
-							
-					case SDL_KEYUP:
-					case SDL_KEYDOWN:
-						ControlManager::handleKeyboardEvent(&event);
-						break;
+					// Select the right texture according to the focus state
+					if (i == focusedMenuItemIndex) pointerTexture = pointerMenu->items[i].pointerFocusedTexture;
+					else pointerTexture = pointerMenu->items[i].pointerNormalTexture;
+					
+					Renderer::renderTexture(pointerTexture, pointerMenu->items[i].x, pointerMenu->items[i].y);
 				}
+				
+				Renderer::endFrame();
+				isRedrawNeeded = false;
 			}
 			
+			// Process SDL events
+			if (_waitForEvents(&isRedrawNeeded) != 0) return -1;
+			
 			// Handle key press
 			// Go up key
 			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_GO_UP))
@@ -145,7 +198,11 @@ namespace Menu
 				if (!isGoUpKeyPressed)
 				{
 					AudioManager::playSound(AudioManager::SOUND_ID_MENU_MOVE);
-					if (focusedMenuItemIndex > 0) focusedMenuItemIndex--;
+					if (focusedMenuItemIndex > 0)
+					{
+						focusedMenuItemIndex--;
+						isRedrawNeeded = true;
+					}
 					isGoUpKeyPressed = 1;
 				}
 			}
@@ -156,7 +213,11 @@ namespace Menu
 				if (!isGoDownKeyPressed)
 				{
 					AudioManager::playSound(AudioManager::SOUND_ID_MENU_MOVE);
-					if (focusedMenuItemIndex < _menuItemsCount - 1) focusedMenuItemIndex++;
+					if (focusedMenuItemIndex < pointerMenu->itemsCount - 1)
+					{
+						focusedMenuItemIndex++;
+						isRedrawNeeded = true;
+					}
 					isGoDownKeyPressed = 1;
 				}
 			}
@@ -168,39 +229,16 @@ namespace Menu
 				AudioManager::playSound(AudioManager::SOUND_ID_MENU_SELECT);
 				SDL_Delay(500); // Wait a bit for the sound to be played, because when this function quits _loadNextLevel() is called and it stops all playing sounds
 				
-				returnValue = focusedMenuItemIndex;
 				LOG_DEBUG("Selected item %d.", focusedMenuItemIndex);
-				goto Exit;
+				return focusedMenuItemIndex;
 			}
-			
-			// Display menu
-			// Display stretched background (so it can fit any screen resolution)
-			SDL_RenderCopy(Renderer::pointerRenderer, TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_MENU_BACKGROUND)->getSDLTexture(), NULL, NULL);
-			// Display title
-			Renderer::renderTexture(_pointerMenuTitleTexture, _menuTitleTextureX, CONFIGURATION_MENU_TITLE_Y);
-			// Display items
-			for (i = 0; i < _menuItemsCount; i++)
-			{
-				// Select the right texture according to the focus state
-				if (i == focusedMenuItemIndex) pointerTexture = _menuItems[i].pointerFocusedTexture;
-				else pointerTexture = _menuItems[i].pointerNormalTexture;
-				
-				Renderer::renderTexture(pointerTexture, _menuItems[i].x, _menuItems[i].y);
-			}
-			
-			Renderer::endFrame();
 		}
-		
-	Exit:
-		// Free resources
-		_uninitialize();
-		return returnValue;
 	}
 	
 	int displayControlsMenu()
 	{
-		SDL_Event event;
-		int returnValue, i, isSelectKeyPressed = 0;
+		int i, isSelectKeyPressed = 0;
+		bool isRedrawNeeded = true;
 		static const char *pointerStringMenuItems[] =
 		{
 			"Arrow keys or WASD : move",
@@ -210,40 +248,35 @@ namespace Menu
 			"Back"
 		};
 		
-		// This variable is shared by all internal functions, it must be initialized before calling any of the functions
-		_menuItemsCount = 5;
-		
-		// Cache textures to display
-		_initialize("Controls", pointerStringMenuItems);
+		// Get textures to display
+		CachedMenu *pointerMenu = _getMenu("Controls", pointerStringMenuItems, 5);
+		MenuItem *pointerBackItem = &pointerMenu->items[pointerMenu->itemsCount - 1];
+		Texture *pointerBackgroundTexture = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_MENU_BACKGROUND);
 		
 		while (1)
 		{
-			Renderer::beginFrame();
-			
-			// Process SDL events
-			while (SDL_PollEvent(&event))
+			// Display menu only when its content changed
+			if (isRedrawNeeded)
 			{
-				switch (event.type)
-				{
-					// User closed the game window or pressed alt+F4
-					case SDL_QUIT:
-						returnValue = -1;
-						LOG_DEBUG("Quitting game.");
-						goto Exit;
-						
-					case SDL_CONTROLLERBUTTONUP:
-					case SDL_CONTROLLERBUTTONDOWN:
-					case SDL_CONTROLLERAXISMOTION:
-						ControlManager::handleGameControllerEvent(&event);
-						break;
-							
-					case SDL_KEYUP:
-					case SDL_KEYDOWN:
-						ControlManager::handleKeyboardEvent(&event);
-						break;
-				}
+				Renderer::beginFrame();
+				
+				// Display stretched background (so it can fit any screen resolution)
+				Renderer::renderTextureArea(pointerBackgroundTexture->getSDLTexture(), pointerBackgroundTexture->getSourceRectangle(), NULL);
+				// Display title
+				Renderer::setLayer(Renderer::LAYER_ID_INTERFACE);
+				Renderer::renderTexture(pointerMenu->pointerTitleTexture, pointerMenu->titleTextureX, CONFIGURATION_MENU_TITLE_Y);
+				// Display items (do not draw the final "Back" texture)
+				for (i = 0; i < pointerMenu->itemsCount - 1; i++) Renderer::renderTexture(pointerMenu->items[i].pointerNormalTexture, 20, pointerMenu->items[i].y); // Use only default color texture and force left alignment
+				// Draw "Back" like it is a selected button
+				Renderer::renderTexture(pointerBackItem->pointerFocusedTexture, pointerBackItem->x, pointerBackItem->y);
+				
+				Renderer::endFrame();
+				isRedrawNeeded = false;
 			}
 			
+			// Process SDL events
+			if (_waitForEvents(&isRedrawNeeded) != 0) return -1;
+			
 			// Handle key press
 			// Select key
 			if (ControlManager::isKeyPressed(ControlManager::KEY_ID_PRIMARY_SHOOT) || ControlManager::isKeyPressed(ControlManager::KEY_ID_MENU_SELECT)) isSelectKeyPressed = 1; // Wait for the key to be released to execute the associated action, so the shoot key is not pressed when entering the game (this avoids the player immediately shooting when entering the game because the shoot key is pressed yet)
@@ -251,26 +284,23 @@ namespace Menu
 			{
 				AudioManager::playSound(AudioManager::SOUND_ID_MENU_SELECT);
 				SDL_Delay(500); // Wait a bit for the sound to be played, because when this function quits _loadNextLevel() is called and it stops all playing sounds
-				returnValue = 0;
-				goto Exit;
+				return 0;
 			}
+		}
+	}
 			
-			// Display menu
-			// Display stretched background (so it can fit any screen resolution)
-			SDL_RenderCopy(Renderer::pointerRenderer, TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_MENU_BACKGROUND)->getSDLTexture(), NULL, NULL);
-			// Display title
-			Renderer::renderTexture(_pointerMenuTitleTexture, _menuTitleTextureX, CONFIGURATION_MENU_TITLE_Y);
-			// Display items (do not draw the final "Back" texture)
-			for (i = 0; i < _menuItemsCount - 1; i++) Renderer::renderTexture(_menuItems[i].pointerNormalTexture, 20, _menuItems[i].y); // Use only default color texture and force left alignment
-			// Draw "Back" like it is a selected button
-			Renderer::renderTexture(_menuItems[_menuItemsCount - 1].pointerFocusedTexture, _menuItems[_menuItemsCount - 1].x, _menuItems[_menuItemsCount - 1].y);
-			
-			Renderer::endFrame();
+	void uninitialize()
+	{
+		std::map<std::string, CachedMenu>::iterator cachedMenusIterator;
+		for (cachedMenusIterator = _cachedMenus.begin(); cachedMenusIterator != _cachedMenus.end(); ++cachedMenusIterator)
+		{
+			Renderer::destroyTexture(cachedMenusIterator->second.pointerTitleTexture);
+			for (int i = 0; i < cachedMenusIterator->second.itemsCount; i++)
+			{
+				Renderer::destroyTexture(cachedMenusIterator->second.items[i].pointerNormalTexture);
+				Renderer::destroyTexture(cachedMenusIterator->second.items[i].pointerFocusedTexture);
+			}
 		}
-		
-		Exit:
-		// Free resources
-		_uninitialize();
-		return returnValue;
+		_cachedMenus.clear();
 	}
 }
@@ -6,6 +6,7 @@
 #include <LevelManager.hpp>
 #include <MovingEntity.hpp>
 #include <Renderer.hpp>
+#include <SimulationClock.hpp>
 
 MovingEntity::MovingEntity(int x, int y, TextureManager::TextureId facingUpTextureId, int movingPixelsAmount)
 {
@@ -31,6 +32,11 @@ MovingEntity::MovingEntity(int x, int y, TextureManager::TextureId facingUpTextu
 	
 	// Entity is facing up on spawn
 	_facingDirection = DIRECTION_UP;
+	
+	// Do not interpolate the spawning position
+	_previousX = x;
+	_previousY = y;
+	_previousPositionTicksCount = SimulationClock::getTicksCount();
 }
 
 MovingEntity::~MovingEntity() {}
@@ -42,6 +48,10 @@ int MovingEntity::getX()
 
 void MovingEntity::setX(int x)
 {
+	// Teleport the entity instead of displaying it moving to the new position
+	_keepPreviousPosition();
+	_previousX = x;
+	
 	// Set all rectangles X coordinate (do not use a loop to fasten the code)
 	_positionRectangles[DIRECTION_UP].x = x;
 	_positionRectangles[DIRECTION_DOWN].x = x;
@@ -56,6 +66,10 @@ int MovingEntity::getY()
 
 void MovingEntity::setY(int y)
 {
+	// Teleport the entity instead of displaying it moving to the new position
+	_keepPreviousPosition();
+	_previousY = y;
+	
 	// Set all rectangles Y coordinate (do not use a loop to fasten the code)
 	_positionRectangles[DIRECTION_UP].y = y;
 	_positionRectangles[DIRECTION_DOWN].y = y;
@@ -63,6 +77,24 @@ void MovingEntity::setY(int y)
 	_positionRectangles[DIRECTION_RIGHT].y = y;
 }
 
+int MovingEntity::getInterpolatedX()
+{
+	// Display the current position if the entity did not move during the last tick
+	int x = _positionRectangles[_facingDirection].x;
+	if (_previousPositionTicksCount != SimulationClock::getTicksCount()) return x;
+	
+	return _previousX + (int) ((x - _previousX) * Renderer::interpolationFactor);
+}
+
+int MovingEntity::getInterpolatedY()
+{
+	// Display the current position if the entity did not move during the last tick
+	int y = _positionRectangles[_facingDirection].y;
+	if (_previousPositionTicksCount != SimulationClock::getTicksCount()) return y;
+	
+	return _previousY + (int) ((y - _previousY) * Renderer::interpolationFactor);
+}
+
 SDL_Rect *MovingEntity::getPositionRectangle()
 {
 	return &_positionRectangles[_facingDirection];
@@ -86,6 +118,7 @@ int MovingEntity::moveToUp()
 	else movingPixelsAmount = distanceToWall;
 	
 	// Update all rectangles
+	_keepPreviousPosition();
 	_positionRectangles[DIRECTION_UP].y -= movingPixelsAmount;
 	_positionRectangles[DIRECTION_DOWN].y -= movingPixelsAmount;
 	_positionRectangles[DIRECTION_LEFT].y -= movingPixelsAmount;
@@ -115,6 +148,7 @@ int MovingEntity::moveToDown()
 	else movingPixelsAmount = distanceToWall;
 	
 	// Update all rectangles
+	_keepPreviousPosition();
 	_positionRectangles[DIRECTION_UP].y += movingPixelsAmount;
 	_positionRectangles[DIRECTION_DOWN].y += movingPixelsAmount;
 	_positionRectangles[DIRECTION_LEFT].y += movingPixelsAmount;
@@ -144,6 +178,7 @@ int MovingEntity::moveToLeft()
 	else movingPixelsAmount = distanceToWall;
 	
 	// Update all rectangles
+	_keepPreviousPosition();
 	_positionRectangles[DIRECTION_UP].x -= movingPixelsAmount;
 	_positionRectangles[DIRECTION_DOWN].x -= movingPixelsAmount;
 	_positionRectangles[DIRECTION_LEFT].x -= movingPixelsAmount;
@@ -173,6 +208,7 @@ int MovingEntity::moveToRight()
 	else movingPixelsAmount = distanceToWall;
 	
 	// Update all rectangles
+	_keepPreviousPosition();
 	_positionRectangles[DIRECTION_UP].x += movingPixelsAmount;
 	_positionRectangles[DIRECTION_DOWN].x += movingPixelsAmount;
 	_positionRectangles[DIRECTION_LEFT].x += movingPixelsAmount;
@@ -227,9 +263,8 @@ void MovingEntity::turnToRight()
 
 void MovingEntity::render()
 {
-	// Display the texture
-	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
-	_pointerTextures[_facingDirection]->render(pointerPositionRectangle->x - Renderer::displayX, pointerPositionRectangle->y - Renderer::displayY);
+	// Display the texture between the previous and the current tick positions
+	_pointerTextures[_facingDirection]->render(getInterpolatedX() - Renderer::displayX, getInterpolatedY() - Renderer::displayY);
 	
 	// Display collision rectangle in debug mode
 	#if CONFIGURATION_LOG_LEVEL == 3
@@ -237,17 +272,23 @@ void MovingEntity::render()
 		SDL_Rect renderingRectangle, *pointerPositionRectangle;
 		
 		// Position rectangle
-		SDL_SetRenderDrawColor(Renderer::pointerRenderer, 0, 255, 255, 255);
-		
 		pointerPositionRectangle = &_positionRectangles[_facingDirection];
 		renderingRectangle.x = pointerPositionRectangle->x - Renderer::displayX;
 		renderingRectangle.y = pointerPositionRectangle->y - Renderer::displayY;
 		renderingRectangle.w = pointerPositionRectangle->w;
 		renderingRectangle.h = pointerPositionRectangle->h;
-		SDL_RenderDrawRect(Renderer::pointerRenderer, &renderingRectangle);
-		
-		// Restore background color
-		SDL_SetRenderDrawColor(Renderer::pointerRenderer, 0, 0, 0, 255);
+		Renderer::renderRectangle(&renderingRectangle, 0, 255, 255);
 	}
 	#endif
 }
+
+void MovingEntity::_keepPreviousPosition()
+{
+	// Only the position the entity had when the tick started is needed
+	unsigned int ticksCount = SimulationClock::getTicksCount();
+	if (_previousPositionTicksCount == ticksCount) return;
+	
+	_previousX = _positionRectangles[_facingDirection].x;
+	_previousY = _positionRectangles[_facingDirection].y;
+	_previousPositionTicksCount = ticksCount;
+}
@@ -0,0 +1,519 @@
+/** @file NavigationManager.cpp
+ * See NavigationManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Configuration.hpp>
+#include <cstdlib>
+#include <functional>
+#include <LevelManager.hpp>
+#include <Log.hpp>
+#include <NavigationManager.hpp>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace NavigationManager
+{
+	/** How many blocks a cluster contains (the clusters on the level right and bottom borders can use less blocks). */
+	#define CLUSTER_BLOCKS_COUNT (CONFIGURATION_NAVIGATION_CLUSTER_SIZE * CONFIGURATION_NAVIGATION_CLUSTER_SIZE)
+
+	/** Compute a block index inside a cluster.
+	* @param pointerCluster The cluster.
+	* @param x X coordinate (in level blocks).
+	* @param y Y coordinate (in level blocks).
+	* @return The corresponding index.
+	*/
+	#define COMPUTE_CLUSTER_BLOCK_INDEX(pointerCluster, x, y) ((((y) - (pointerCluster)->yBlock) * CONFIGURATION_NAVIGATION_CLUSTER_SIZE) + ((x) - (pointerCluster)->xBlock))
+
+	/** A block of a cluster border facing a walkable block of the neighbor cluster. */
+	typedef struct
+	{
+		int xBlock; //!< The portal X coordinate in level blocks.
+		int yBlock; //!< The portal Y coordinate in level blocks.
+		int linkedClusterIndex; //!< The cluster on the other side of the border.
+		int linkedXBlock; //!< The X coordinate in level blocks of the facing portal.
+		int linkedYBlock; //!< The Y coordinate in level blocks of the facing portal.
+		int linkedNodeIndex; //!< The facing portal in the portals graph.
+		int distances[CLUSTER_BLOCKS_COUNT]; //!< How many blocks separate each cluster block from the portal without leaving the cluster, or -1 if the block can't be reached.
+	} Portal;
+
+	/** A square part of the level. */
+	typedef struct
+	{
+		int xBlock; //!< The cluster top left block X coordinate in level blocks.
+		int yBlock; //!< The cluster top left block Y coordinate in level blocks.
+		int widthBlocks; //!< The cluster width in blocks.
+		int heightBlocks; //!< The cluster height in blocks.
+		std::vector<Portal> portals; //!< All portals located on the cluster borders.
+		int firstNodeIndex; //!< The portals graph node of the first cluster portal, the other portals follow.
+		bool isModified; //!< Tell whether the cluster portals must be computed again.
+	} Cluster;
+
+	/** The level width in blocks. */
+	static int _levelWidthBlocks = 0;
+	/** The level height in blocks. */
+	static int _levelHeightBlocks = 0;
+	/** How many clusters are needed to cover the level width. */
+	static int _clustersColumnsCount;
+	/** How many clusters are needed to cover the level height. */
+	static int _clustersRowsCount;
+
+	/** All level clusters, row after row. */
+	static std::vector<Cluster> _clusters;
+	/** Tell whether at least one cluster must be computed again. */
+	static bool _isClusterModified = false;
+
+	/** The cluster owning each portals graph node. */
+	static std::vector<int> _nodeClusterIndexes;
+	/** How many blocks separate each portals graph node from the player, or -1 if the node can't reach the player. */
+	static std::vector<int> _nodePlayerDistances;
+
+	/** The level block the player was on when the distances have been computed, or -1 if the distances must be computed again. */
+	static int _playerBlockIndex = -1;
+	/** The cluster containing the player block. */
+	static int _playerClusterIndex = -1;
+	/** How many blocks separate each block of the player cluster from the player without leaving the cluster. */
+	static int _playerClusterDistances[CLUSTER_BLOCKS_COUNT];
+
+	/** Tell which blocks of the cluster being computed are walls or enemy spawners. */
+	static bool _clusterObstacles[CLUSTER_BLOCKS_COUNT];
+	/** The blocks to visit by the breadth-first search, each block is queued only once. */
+	static int _clusterBlocksQueue[CLUSTER_BLOCKS_COUNT];
+
+	/** Tell if the player and the enemies can't walk on a level block.
+	* @param xBlock X coordinate (in level blocks).
+	* @param yBlock Y coordinate (in level blocks).
+	* @return true if the block is a wall or an enemy spawner,
+	* @return false if the block can be crossed.
+	*/
+	static inline bool _isObstacle(int xBlock, int yBlock)
+	{
+		return (LevelManager::getBlockContent(xBlock * CONFIGURATION_LEVEL_BLOCK_SIZE, yBlock * CONFIGURATION_LEVEL_BLOCK_SIZE) & (LevelManager::BLOCK_CONTENT_WALL | LevelManager::BLOCK_CONTENT_ENEMY_SPAWNER)) != 0;
+	}
+
+	/** Cache the obstacles of a cluster to the _clusterObstacles array.
+	* @param pointerCluster The cluster.
+	*/
+	static void _loadClusterObstacles(Cluster *pointerCluster)
+	{
+		int x, y;
+		
+		for (y = pointerCluster->yBlock; y < pointerCluster->yBlock + pointerCluster->heightBlocks; y++)
+		{
+			for (x = pointerCluster->xBlock; x < pointerCluster->xBlock + pointerCluster->widthBlocks; x++) _clusterObstacles[COMPUTE_CLUSTER_BLOCK_INDEX(pointerCluster, x, y)] = _isObstacle(x, y);
+		}
+	}
+
+	/** Compute how many blocks separate each cluster block from a starting block without leaving the cluster.
+	* @param pointerCluster The cluster, its obstacles must have been loaded by _loadClusterObstacles().
+	* @param xBlock The starting block X coordinate in level blocks.
+	* @param yBlock The starting block Y coordinate in level blocks.
+	* @param pointerDistances On output, contain the distance of each cluster block, or -1 if the block can't be reached.
+	*/
+	static void _computeClusterDistances(Cluster *pointerCluster, int xBlock, int yBlock, int *pointerDistances)
+	{
+		int blockIndex, neighborBlockIndex, x, y, distance, queueReadIndex, queueWriteIndex = 0, i;
+		
+		// No block has been reached yet
+		for (i = 0; i < CLUSTER_BLOCKS_COUNT; i++) pointerDistances[i] = -1;
+		
+		// Spread the distances from the starting block, all blocks of a distance are visited before the blocks of the next distance
+		blockIndex = COMPUTE_CLUSTER_BLOCK_INDEX(pointerCluster, xBlock, yBlock);
+		pointerDistances[blockIndex] = 0;
+		_clusterBlocksQueue[queueWriteIndex] = blockIndex;
+		queueWriteIndex++;
+		for (queueReadIndex = 0; queueReadIndex < queueWriteIndex; queueReadIndex++)
+		{
+			blockIndex = _clusterBlocksQueue[queueReadIndex];
+			x = blockIndex % CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+			y = blockIndex / CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+			distance = pointerDistances[blockIndex] + 1;
+			
+			// Visit the four neighbors without leaving the cluster
+			for (i = 0; i < 4; i++)
+			{
+				switch (i)
+				{
+					case 0:
+						if (y == 0) continue;
+						neighborBlockIndex = blockIndex - CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+						break;
+
+					case 1:
+						if (y == pointerCluster->heightBlocks - 1) continue;
+						neighborBlockIndex = blockIndex + CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+						break;
+
+					case 2:
+						if (x == 0) continue;
+						neighborBlockIndex = blockIndex - 1;
+						break;
+
+					default:
+						if (x == pointerCluster->widthBlocks - 1) continue;
+						neighborBlockIndex = blockIndex + 1;
+						break;
+				}
+				
+				if ((pointerDistances[neighborBlockIndex] != -1) || _clusterObstacles[neighborBlockIndex]) continue;
+				
+				pointerDistances[neighborBlockIndex] = distance;
+				_clusterBlocksQueue[queueWriteIndex] = neighborBlockIndex;
+				queueWriteIndex++;
+			}
+		}
+	}
+
+	/** Find the openings of a cluster border and add their portals to the cluster.
+	* @param pointerCluster The cluster.
+	* @param linkedClusterIndex The cluster on the other side of the border.
+	* @param xBlock The X coordinate in level blocks of the first border block inside the cluster.
+	* @param yBlock The Y coordinate in level blocks of the first border block inside the cluster.
+	* @param xStep How many blocks to add to X to get the next border block.
+	* @param yStep How many blocks to add to Y to get the next border block.
+	* @param xOffset How many blocks to add to a border block X coordinate to get the facing block in the other cluster.
+	* @param yOffset How many blocks to add to a border block Y coordinate to get the facing block in the other cluster.
+	* @param borderLengthBlocks The border length in blocks.
+	*/
+	static void _addBorderPortals(Cluster *pointerCluster, int linkedClusterIndex, int xBlock, int yBlock, int xStep, int yStep, int xOffset, int yOffset, int borderLengthBlocks)
+	{
+		int i, j, openingStartIndex = -1, openingLength, portalsCount, portalIndex;
+		bool isOpen;
+		Portal portal;
+		
+		// Look one block past the border end to close the last opening
+		for (i = 0; i <= borderLengthBlocks; i++)
+		{
+			if (i < borderLengthBlocks) isOpen = !_isObstacle(xBlock + (i * xStep), yBlock + (i * yStep)) && !_isObstacle(xBlock + (i * xStep) + xOffset, yBlock + (i * yStep) + yOffset);
+			else isOpen = false;
+			
+			// Wait for the end of the opening
+			if (isOpen)
+			{
+				if (openingStartIndex == -1) openingStartIndex = i;
+				continue;
+			}
+			if (openingStartIndex == -1) continue;
+			
+			// Spread the portals on the opening, so the paths do not make a detour to cross wide openings (both clusters of the border find the same portals)
+			openingLength = i - openingStartIndex;
+			portalsCount = (openingLength + CONFIGURATION_NAVIGATION_PORTALS_SPACING - 1) / CONFIGURATION_NAVIGATION_PORTALS_SPACING;
+			for (j = 0; j < portalsCount; j++)
+			{
+				portalIndex = openingStartIndex + ((((2 * j) + 1) * openingLength) / (2 * portalsCount));
+				portal.xBlock = xBlock + (portalIndex * xStep);
+				portal.yBlock = yBlock + (portalIndex * yStep);
+				portal.linkedClusterIndex = linkedClusterIndex;
+				portal.linkedXBlock = portal.xBlock + xOffset;
+				portal.linkedYBlock = portal.yBlock + yOffset;
+				portal.linkedNodeIndex = -1;
+				pointerCluster->portals.push_back(portal);
+			}
+			openingStartIndex = -1;
+		}
+	}
+
+	/** Find the portals of a cluster and the distances from each portal to the cluster blocks.
+	* @param clusterIndex The cluster.
+	*/
+	static void _computeCluster(int clusterIndex)
+	{
+		Cluster *pointerCluster = &_clusters[clusterIndex];
+		int clusterColumn = clusterIndex % _clustersColumnsCount, clusterRow = clusterIndex / _clustersColumnsCount;
+		unsigned int i;
+		
+		// Find the openings toward each neighbor cluster
+		pointerCluster->portals.clear();
+		if (clusterRow > 0) _addBorderPortals(pointerCluster, clusterIndex - _clustersColumnsCount, pointerCluster->xBlock, pointerCluster->yBlock, 1, 0, 0, -1, pointerCluster->widthBlocks);
+		if (clusterRow < _clustersRowsCount - 1) _addBorderPortals(pointerCluster, clusterIndex + _clustersColumnsCount, pointerCluster->xBlock, pointerCluster->yBlock + pointerCluster->heightBlocks - 1, 1, 0, 0, 1, pointerCluster->widthBlocks);
+		if (clusterColumn > 0) _addBorderPortals(pointerCluster, clusterIndex - 1, pointerCluster->xBlock, pointerCluster->yBlock, 0, 1, -1, 0, pointerCluster->heightBlocks);
+		if (clusterColumn < _clustersColumnsCount - 1) _addBorderPortals(pointerCluster, clusterIndex + 1, pointerCluster->xBlock + pointerCluster->widthBlocks - 1, pointerCluster->yBlock, 0, 1, 1, 0, pointerCluster->heightBlocks);
+		
+		// Cache the paths inside the cluster
+		_loadClusterObstacles(pointerCluster);
+		for (i = 0; i < pointerCluster->portals.size(); i++) _computeClusterDistances(pointerCluster, pointerCluster->portals[i].xBlock, pointerCluster->portals[i].yBlock, pointerCluster->portals[i].distances);
+		
+		pointerCluster->isModified = false;
+	}
+
+	/** Number the portals of all clusters and find the facing portal of each portal. */
+	static void _linkPortals()
+	{
+		int nodesCount = 0, clusterIndex, linkedPortalIndex;
+		unsigned int i;
+		Cluster *pointerCluster, *pointerLinkedCluster;
+		Portal *pointerPortal;
+		
+		// Give consecutive node indexes to the portals of a cluster
+		_nodeClusterIndexes.clear();
+		for (clusterIndex = 0; clusterIndex < (int) _clusters.size(); clusterIndex++)
+		{
+			pointerCluster = &_clusters[clusterIndex];
+			pointerCluster->firstNodeIndex = nodesCount;
+			nodesCount += pointerCluster->portals.size();
+			_nodeClusterIndexes.resize(nodesCount, clusterIndex);
+		}
+		
+		// Both clusters of a border found the same openings, so each portal has a facing one
+		for (clusterIndex = 0; clusterIndex < (int) _clusters.size(); clusterIndex++)
+		{
+			pointerCluster = &_clusters[clusterIndex];
+			for (i = 0; i < pointerCluster->portals.size(); i++)
+			{
+				pointerPortal = &pointerCluster->portals[i];
+				pointerLinkedCluster = &_clusters[pointerPortal->linkedClusterIndex];
+				for (linkedPortalIndex = 0; linkedPortalIndex < (int) pointerLinkedCluster->portals.size(); linkedPortalIndex++)
+				{
+					if ((pointerLinkedCluster->portals[linkedPortalIndex].xBlock == pointerPortal->linkedXBlock) && (pointerLinkedCluster->portals[linkedPortalIndex].yBlock == pointerPortal->linkedYBlock)) break;
+				}
+				
+				if (linkedPortalIndex == (int) pointerLinkedCluster->portals.size())
+				{
+					LOG_ERROR("Could not find the portal facing the block (%d, %d).", pointerPortal->xBlock, pointerPortal->yBlock);
+					pointerPortal->linkedNodeIndex = -1;
+				}
+				else pointerPortal->linkedNodeIndex = pointerLinkedCluster->firstNodeIndex + linkedPortalIndex;
+			}
+		}
+		
+		// The nodes changed, so the distances must be computed again
+		_nodePlayerDistances.assign(nodesCount, -1);
+		_playerBlockIndex = -1;
+		_playerClusterIndex = -1;
+	}
+
+	void loadLevel(int levelWidthBlocks, int levelHeightBlocks)
+	{
+		int clusterIndex, clusterColumn, clusterRow;
+		Cluster *pointerCluster;
+		
+		_levelWidthBlocks = levelWidthBlocks;
+		_levelHeightBlocks = levelHeightBlocks;
+		_clustersColumnsCount = (levelWidthBlocks + CONFIGURATION_NAVIGATION_CLUSTER_SIZE - 1) / CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+		_clustersRowsCount = (levelHeightBlocks + CONFIGURATION_NAVIGATION_CLUSTER_SIZE - 1) / CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+		
+		// Cut the level in clusters
+		_clusters.clear();
+		_clusters.resize(_clustersColumnsCount * _clustersRowsCount);
+		for (clusterIndex = 0; clusterIndex < (int) _clusters.size(); clusterIndex++)
+		{
+			pointerCluster = &_clusters[clusterIndex];
+			clusterColumn = clusterIndex % _clustersColumnsCount;
+			clusterRow = clusterIndex / _clustersColumnsCount;
+			pointerCluster->xBlock = clusterColumn * CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+			pointerCluster->yBlock = clusterRow * CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+			pointerCluster->widthBlocks = levelWidthBlocks - pointerCluster->xBlock;
+			if (pointerCluster->widthBlocks > CONFIGURATION_NAVIGATION_CLUSTER_SIZE) pointerCluster->widthBlocks = CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+			pointerCluster->heightBlocks = levelHeightBlocks - pointerCluster->yBlock;
+			if (pointerCluster->heightBlocks > CONFIGURATION_NAVIGATION_CLUSTER_SIZE) pointerCluster->heightBlocks = CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+			
+			_computeCluster(clusterIndex);
+		}
+		_isClusterModified = false;
+		
+		_linkPortals();
+		LOG_DEBUG("Level divided in %dx%d clusters with %d portals.", _clustersColumnsCount, _clustersRowsCount, (int) _nodeClusterIndexes.size());
+	}
+
+	void setBlockModified(int x, int y)
+	{
+		// Convert coordinates to blocks
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		
+		// The block cluster paths change
+		int clusterColumn = xBlock / CONFIGURATION_NAVIGATION_CLUSTER_SIZE, clusterRow = yBlock / CONFIGURATION_NAVIGATION_CLUSTER_SIZE;
+		int clusterIndex = (clusterRow * _clustersColumnsCount) + clusterColumn;
+		_clusters[clusterIndex].isModified = true;
+		
+		// A block on a cluster border can also open or close a portal of the neighbor cluster
+		if ((xBlock % CONFIGURATION_NAVIGATION_CLUSTER_SIZE == 0) && (clusterColumn > 0)) _clusters[clusterIndex - 1].isModified = true;
+		if ((xBlock % CONFIGURATION_NAVIGATION_CLUSTER_SIZE == CONFIGURATION_NAVIGATION_CLUSTER_SIZE - 1) && (clusterColumn < _clustersColumnsCount - 1)) _clusters[clusterIndex + 1].isModified = true;
+		if ((yBlock % CONFIGURATION_NAVIGATION_CLUSTER_SIZE == 0) && (clusterRow > 0)) _clusters[clusterIndex - _clustersColumnsCount].isModified = true;
+		if ((yBlock % CONFIGURATION_NAVIGATION_CLUSTER_SIZE == CONFIGURATION_NAVIGATION_CLUSTER_SIZE - 1) && (clusterRow < _clustersRowsCount - 1)) _clusters[clusterIndex + _clustersColumnsCount].isModified = true;
+		
+		_isClusterModified = true;
+	}
+
+	void updatePlayerDistances(int playerCenterX, int playerCenterY)
+	{
+		int playerXBlock = playerCenterX / CONFIGURATION_LEVEL_BLOCK_SIZE, playerYBlock = playerCenterY / CONFIGURATION_LEVEL_BLOCK_SIZE, playerBlockIndex, clusterIndex, nodeIndex, distance;
+		unsigned int i;
+		Cluster *pointerCluster;
+		Portal *pointerPortal;
+		
+		// Compute again only the clusters whose blocks changed
+		if (_isClusterModified)
+		{
+			for (clusterIndex = 0; clusterIndex < (int) _clusters.size(); clusterIndex++)
+			{
+				if (_clusters[clusterIndex].isModified) _computeCluster(clusterIndex);
+			}
+			_isClusterModified = false;
+			
+			_linkPortals();
+		}
+		
+		// Nothing to do while the player stays in the same block
+		playerBlockIndex = (playerYBlock * _levelWidthBlocks) + playerXBlock;
+		if (playerBlockIndex == _playerBlockIndex) return;
+		_playerBlockIndex = playerBlockIndex;
+		
+		// Find the paths to the player inside its cluster
+		_playerClusterIndex = ((playerYBlock / CONFIGURATION_NAVIGATION_CLUSTER_SIZE) * _clustersColumnsCount) + (playerXBlock / CONFIGURATION_NAVIGATION_CLUSTER_SIZE);
+		pointerCluster = &_clusters[_playerClusterIndex];
+		_loadClusterObstacles(pointerCluster);
+		_computeClusterDistances(pointerCluster, playerXBlock, playerYBlock, _playerClusterDistances);
+		
+		// Start the search of the portals graph from the player cluster portals (a distance is stored with its node, the closest node is always visited first)
+		std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int> >, std::greater<std::pair<int, int> > > nodesQueue;
+		_nodePlayerDistances.assign(_nodePlayerDistances.size(), -1);
+		for (i = 0; i < pointerCluster->portals.size(); i++)
+		{
+			pointerPortal = &pointerCluster->portals[i];
+			distance = _playerClusterDistances[COMPUTE_CLUSTER_BLOCK_INDEX(pointerCluster, pointerPortal->xBlock, pointerPortal->yBlock)];
+			if (distance == -1) continue;
+			
+			nodeIndex = pointerCluster->firstNodeIndex + i;
+			_nodePlayerDistances[nodeIndex] = distance;
+			nodesQueue.push(std::make_pair(distance, nodeIndex));
+		}
+		
+		// Spread the distances through the portals of the same cluster and through the facing portals
+		while (!nodesQueue.empty())
+		{
+			distance = nodesQueue.top().first;
+			nodeIndex = nodesQueue.top().second;
+			nodesQueue.pop();
+			
+			// This node has already been reached by a shorter path
+			if (distance > _nodePlayerDistances[nodeIndex]) continue;
+			
+			pointerCluster = &_clusters[_nodeClusterIndexes[nodeIndex]];
+			pointerPortal = &pointerCluster->portals[nodeIndex - pointerCluster->firstNodeIndex];
+			
+			// Cross the border
+			if ((pointerPortal->linkedNodeIndex != -1) && ((_nodePlayerDistances[pointerPortal->linkedNodeIndex] == -1) || (distance + 1 < _nodePlayerDistances[pointerPortal->linkedNodeIndex])))
+			{
+				_nodePlayerDistances[pointerPortal->linkedNodeIndex] = distance + 1;
+				nodesQueue.push(std::make_pair(distance + 1, pointerPortal->linkedNodeIndex));
+			}
+			
+			// Walk to the other portals of the cluster (a corner block holds two portals, which are separated by no block)
+			for (i = 0; i < pointerCluster->portals.size(); i++)
+			{
+				int otherNodeIndex = pointerCluster->firstNodeIndex + i;
+				if (otherNodeIndex == nodeIndex) continue;
+				int pathLength = pointerPortal->distances[COMPUTE_CLUSTER_BLOCK_INDEX(pointerCluster, pointerCluster->portals[i].xBlock, pointerCluster->portals[i].yBlock)];
+				if (pathLength == -1) continue;
+				
+				if ((_nodePlayerDistances[otherNodeIndex] == -1) || (distance + pathLength < _nodePlayerDistances[otherNodeIndex]))
+				{
+					_nodePlayerDistances[otherNodeIndex] = distance + pathLength;
+					nodesQueue.push(std::make_pair(distance + pathLength, otherNodeIndex));
+				}
+			}
+		}
+	}
+
+	int getPlayerDistance(int x, int y)
+	{
+		// Blocks outside of the level can't be crossed
+		if ((x < 0) || (y < 0)) return -1;
+		int xBlock = x / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		int yBlock = y / CONFIGURATION_LEVEL_BLOCK_SIZE;
+		if ((xBlock >= _levelWidthBlocks) || (yBlock >= _levelHeightBlocks)) return -1;
+		
+		int clusterIndex = ((yBlock / CONFIGURATION_NAVIGATION_CLUSTER_SIZE) * _clustersColumnsCount) + (xBlock / CONFIGURATION_NAVIGATION_CLUSTER_SIZE);
+		Cluster *pointerCluster = &_clusters[clusterIndex];
+		int blockIndex = COMPUTE_CLUSTER_BLOCK_INDEX(pointerCluster, xBlock, yBlock), bestDistance = -1, portalDistance, blockDistance;
+		
+		// The player can be reached without leaving its cluster
+		if (clusterIndex == _playerClusterIndex) bestDistance = _playerClusterDistances[blockIndex];
+		
+		// Go through the cluster portal which is the closest to the player
+		for (unsigned int i = 0; i < pointerCluster->portals.size(); i++)
+		{
+			portalDistance = _nodePlayerDistances[pointerCluster->firstNodeIndex + i];
+			blockDistance = pointerCluster->portals[i].distances[blockIndex];
+			if ((portalDistance == -1) || (blockDistance == -1)) continue;
+			
+			if ((bestDistance == -1) || (portalDistance + blockDistance < bestDistance)) bestDistance = portalDistance + blockDistance;
+		}
+		
+		return bestDistance;
+	}
+
+	int checkPlayerDistances(int checksCount)
+	{
+		static const int neighborXOffsets[4] = {0, 0, -1, 1}, neighborYOffsets[4] = {-1, 1, 0, 0};
+		std::vector<int> exactDistances;
+		std::queue<int> blocksQueue;
+		int i, j, attemptsCount, playerXBlock = 0, playerYBlock = 0, xBlock, yBlock, neighborXBlock, neighborYBlock, blockIndex, distance, wrongBlocksCount = 0;
+		bool isCloserNeighborFound;
+		
+		for (i = 0; i < checksCount; i++)
+		{
+			// Put the player on a random walkable block
+			for (attemptsCount = 0; attemptsCount < 1000; attemptsCount++)
+			{
+				playerXBlock = rand() % _levelWidthBlocks;
+				playerYBlock = rand() % _levelHeightBlocks;
+				if (!_isObstacle(playerXBlock, playerYBlock)) break;
+			}
+			if (attemptsCount == 1000) break;
+			updatePlayerDistances((playerXBlock * CONFIGURATION_LEVEL_BLOCK_SIZE) + (CONFIGURATION_LEVEL_BLOCK_SIZE / 2), (playerYBlock * CONFIGURATION_LEVEL_BLOCK_SIZE) + (CONFIGURATION_LEVEL_BLOCK_SIZE / 2));
+			
+			// Find the exact distances by spreading from the player block through the whole level
+			exactDistances.assign(_levelWidthBlocks * _levelHeightBlocks, -1);
+			blockIndex = (playerYBlock * _levelWidthBlocks) + playerXBlock;
+			exactDistances[blockIndex] = 0;
+			blocksQueue.push(blockIndex);
+			while (!blocksQueue.empty())
+			{
+				blockIndex = blocksQueue.front();
+				blocksQueue.pop();
+				
+				for (j = 0; j < 4; j++)
+				{
+					neighborXBlock = (blockIndex % _levelWidthBlocks) + neighborXOffsets[j];
+					neighborYBlock = (blockIndex / _levelWidthBlocks) + neighborYOffsets[j];
+					if ((neighborXBlock < 0) || (neighborXBlock >= _levelWidthBlocks) || (neighborYBlock < 0) || (neighborYBlock >= _levelHeightBlocks)) continue;
+					if ((exactDistances[(neighborYBlock * _levelWidthBlocks) + neighborXBlock] != -1) || _isObstacle(neighborXBlock, neighborYBlock)) continue;
+					
+					exactDistances[(neighborYBlock * _levelWidthBlocks) + neighborXBlock] = exactDistances[blockIndex] + 1;
+					blocksQueue.push((neighborYBlock * _levelWidthBlocks) + neighborXBlock);
+				}
+			}
+			
+			// Compare with the distances found through the portals
+			for (yBlock = 0; yBlock < _levelHeightBlocks; yBlock++)
+			{
+				for (xBlock = 0; xBlock < _levelWidthBlocks; xBlock++)
+				{
+					blockIndex = (yBlock * _levelWidthBlocks) + xBlock;
+					distance = getPlayerDistance(xBlock * CONFIGURATION_LEVEL_BLOCK_SIZE, yBlock * CONFIGURATION_LEVEL_BLOCK_SIZE);
+					
+					// The player block must be the only one at distance 0, and the others must lead to it
+					isCloserNeighborFound = (distance == 0);
+					for (j = 0; (j < 4) && !isCloserNeighborFound; j++)
+					{
+						int neighborDistance = getPlayerDistance((xBlock + neighborXOffsets[j]) * CONFIGURATION_LEVEL_BLOCK_SIZE, (yBlock + neighborYOffsets[j]) * CONFIGURATION_LEVEL_BLOCK_SIZE);
+						if ((neighborDistance != -1) && (neighborDistance < distance)) isCloserNeighborFound = true;
+					}
+					
+					if (exactDistances[blockIndex] == -1)
+					{
+						if (distance == -1) continue;
+					}
+					else if ((distance >= exactDistances[blockIndex]) && ((distance == 0) == (exactDistances[blockIndex] == 0)) && isCloserNeighborFound) continue;
+					
+					LOG_ERROR("Wrong distance %d for block (%d, %d) with the player on block (%d, %d), the exact distance is %d.", distance, xBlock, yBlock, playerXBlock, playerYBlock, exactDistances[blockIndex]);
+					wrongBlocksCount++;
+				}
+			}
+		}
+		
+		return wrongBlocksCount;
+	}
+}
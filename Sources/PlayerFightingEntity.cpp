@@ -10,7 +10,9 @@
 #include <Log.hpp>
 #include <PlayerFightingEntity.hpp>
 #include <Renderer.hpp>
+#include <SimulationClock.hpp>
 #include <TextureManager.hpp>
+#include <TimerManager.hpp>
 
 PlayerFightingEntity::PlayerFightingEntity(int x, int y): FightingEntity(x, y, TextureManager::TEXTURE_ID_PLAYER_FACING_UP, 3, CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_LIFE_POINTS_AMOUNT, CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_PRIMARY_FIRE_TIME_BETWEEN_TWO_SHOTS, TextureManager::TEXTURE_ID_PLAYER_BULLET_FACING_UP, EffectManager::EFFECT_ID_PLAYER_MUZZLE_FLASH_FACING_UP)
 {
@@ -24,7 +26,9 @@ PlayerFightingEntity::PlayerFightingEntity(int x, int y): FightingEntity(x, y, T
 	
 	// Allow to shoot immediately
 	_secondaryFireTimeBetweenShots = 9500; // Slightly faster than a big enemy reloading time
-	_secondaryFireLastShotTime = -_secondaryFireTimeBetweenShots;
+	_secondaryFireReloadingTimerId = TimerManager::TIMER_ID_NONE;
+	_bonusTimerId = TimerManager::TIMER_ID_NONE;
+	_updateMortarHudState();
 	
 	// Cache bullet and firing effect position offsets
 	_computeBulletStartingPositionOffsets(_pointerTextures[DIRECTION_UP], TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_BULLET_MORTAR_SHELL_FACING_UP), _secondaryFireStartingPositionOffsets);
@@ -39,7 +43,12 @@ PlayerFightingEntity::PlayerFightingEntity(int x, int y): FightingEntity(x, y, T
 	_secondaryFireFiringEffectStartingPositionOffsets[DIRECTION_RIGHT].y = CONFIGURATION_PLAYER_MUZZLE_FLASH_MORTAR_SHELL_FACING_RIGHT_STARTING_POSITION_OFFSET_Y;
 }
 
-PlayerFightingEntity::~PlayerFightingEntity() {}
+PlayerFightingEntity::~PlayerFightingEntity()
+{
+	// Do not let the timers access a deleted player
+	TimerManager::cancel(_secondaryFireReloadingTimerId);
+	TimerManager::cancel(_bonusTimerId);
+}
 
 bool PlayerFightingEntity::modifyLife(int lifePointsAmount)
 {
@@ -60,7 +69,11 @@ BulletMovingEntity *PlayerFightingEntity::shoot()
 	BulletMovingEntity *pointerBullet = FightingEntity::shoot();
 	if (pointerBullet != NULL)
 	{
-		if (_currentActiveBonus != BONUS_MACHINE_GUN) _ammunitionAmount--; // Ammunition are unlimited with "machine gun" bonus
+		if (_currentActiveBonus != BONUS_MACHINE_GUN) // Ammunition are unlimited with "machine gun" bonus
+		{
+			_ammunitionAmount--;
+			_updateMortarHudState();
+		}
 		return pointerBullet;
 	}
 	return NULL;
@@ -94,9 +107,9 @@ BulletMovingEntity *PlayerFightingEntity::shootSecondaryFire()
 		// There are enough ammunition to also play the reloading effect (it can be started at the same time that the firing sound because there is a purposely added delay in reloading sound)
 		if (_ammunitionAmount >= CONFIGURATION_GAMEPLAY_PLAYER_SECONDARY_FIRE_NEEDED_AMMUNITION_AMOUNT) AudioManager::playSound(AudioManager::SOUND_ID_PLAYER_MORTAR_SHELL_RELOADING);
 		
-		// Get time after having generated the bullet, in case this takes more than 1 millisecond
 		_isSecondaryShootReloadingTimeElapsed = false;
-		_secondaryFireLastShotTime = SDL_GetTicks();
+		_secondaryFireReloadingTimerId = TimerManager::schedule(_secondaryFireTimeBetweenShots, _secondaryFireReloadingTimerCallback, this);
+		_updateMortarHudState();
 		
 		return pointerBullet;
 	}
@@ -112,38 +125,8 @@ void PlayerFightingEntity::render()
 
 int PlayerFightingEntity::update()
 {
-	// Check whether the mortar reloading time has elapsed
-	if (SDL_GetTicks() - _secondaryFireLastShotTime >= _secondaryFireTimeBetweenShots) _isSecondaryShootReloadingTimeElapsed = true;
-	
-	// Update mortar HUD state
-	if (_ammunitionAmount < CONFIGURATION_GAMEPLAY_PLAYER_SECONDARY_FIRE_NEEDED_AMMUNITION_AMOUNT) HeadUpDisplay::setMortarState(HeadUpDisplay::MORTAR_STATE_LOW_AMMUNITION);
-	else
-	{
-		if (!_isSecondaryShootReloadingTimeElapsed) HeadUpDisplay::setMortarState(HeadUpDisplay::MORTAR_STATE_RELOADING);
-		else HeadUpDisplay::setMortarState(HeadUpDisplay::MORTAR_STATE_READY);
-	}
-	
-	// Handle bonus
-	if (_bonusRemainingTime > 0)
-	{
-		HeadUpDisplay::setRemainingBonusTime(((_bonusRemainingTime * CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS) / 1000) + 1); // Convert frame time to seconds, add one more second to compensate for integer computation rounding
-		_bonusRemainingTime--;
-	}
-	else
-	{
-		// Disable bonus time displaying
-		HeadUpDisplay::setRemainingBonusTime(0);
-		
-		// Restore player default attributes
-		_timeBetweenShots = CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_PRIMARY_FIRE_TIME_BETWEEN_TWO_SHOTS;
-		_currentActiveBonus = BONUS_NONE;
-		
-		// Restore default player skin
-		_pointerTextures[DIRECTION_UP] = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_UP);
-		_pointerTextures[DIRECTION_DOWN] = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_DOWN);
-		_pointerTextures[DIRECTION_LEFT] = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_LEFT);
-		_pointerTextures[DIRECTION_RIGHT] = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_RIGHT);
-	}
+	// Cache the current time (the mortar reloading and the bonus ending are handled by timers)
+	unsigned int currentTime = SimulationClock::getTime();
 	
 	// Cache player center coordinates
 	SDL_Rect *pointerPositionRectangle = &_positionRectangles[_facingDirection];
@@ -208,12 +191,14 @@ int PlayerFightingEntity::update()
 		LOG_DEBUG("Player is crossing a block containing machine gun bonus.");
 		
 		// Bonus can't be taken if another bonus is currently in use
-		if (_bonusRemainingTime == 0)
+		if (_currentActiveBonus == BONUS_NONE)
 		{
 			// Configure bonus
-			_bonusRemainingTime = 30000 / CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS; // Initialize timer, bonus effect lasts 30s (this method is called each game frame, so adjust time)
+			_bonusEndingTime = currentTime + 30000; // Bonus effect lasts 30s
 			_timeBetweenShots = CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_PRIMARY_FIRE_TIME_BETWEEN_TWO_SHOTS / 3; // Make shoots three times faster
+			_updateReloadingTimer();
 			_currentActiveBonus = BONUS_MACHINE_GUN;
+			_updateBonus();
 			
 			EffectManager::addEffect(blockX, blockY, EffectManager::EFFECT_ID_MACHINE_GUN_TAKEN);
 			LOG_DEBUG("Player got machine gun bonus.");
@@ -235,11 +220,12 @@ int PlayerFightingEntity::update()
 		LOG_DEBUG("Player is crossing a block containing bulletproof vest bonus.");
 		
 		// Bonus can't be taken if another bonus is currently in use
-		if (_bonusRemainingTime == 0)
+		if (_currentActiveBonus == BONUS_NONE)
 		{
 			// Configure bonus
-			_bonusRemainingTime = 45000 / CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS; // Initialize timer, bonus effect lasts 45s (this method is called each game frame, so adjust time)
+			_bonusEndingTime = currentTime + 45000; // Bonus effect lasts 45s
 			_currentActiveBonus = BONUS_BULLETPROOF_VEST;
+			_updateBonus();
 			
 			EffectManager::addEffect(blockX, blockY, EffectManager::EFFECT_ID_BULLETPROOF_VEST_TAKEN);
 			LOG_DEBUG("Player got bulletproof vest bonus.");
@@ -265,3 +251,57 @@ BulletMovingEntity *PlayerFightingEntity::_fireBullet(int x, int y)
 {
 	return new BulletMovingEntity(x, y, TextureManager::TEXTURE_ID_PLAYER_BULLET_FACING_UP, 6, _facingDirection, 1, 1);
 }
+
+void PlayerFightingEntity::_updateMortarHudState()
+{
+	if (_ammunitionAmount < CONFIGURATION_GAMEPLAY_PLAYER_SECONDARY_FIRE_NEEDED_AMMUNITION_AMOUNT) HeadUpDisplay::setMortarState(HeadUpDisplay::MORTAR_STATE_LOW_AMMUNITION);
+	else
+	{
+		if (!_isSecondaryShootReloadingTimeElapsed) HeadUpDisplay::setMortarState(HeadUpDisplay::MORTAR_STATE_RELOADING);
+		else HeadUpDisplay::setMortarState(HeadUpDisplay::MORTAR_STATE_READY);
+	}
+}
+
+void PlayerFightingEntity::_updateBonus()
+{
+	int bonusRemainingTime = (int) (_bonusEndingTime - SimulationClock::getTime()); // Signed difference becomes negative once the ending time is reached
+	if (bonusRemainingTime > 0)
+	{
+		HeadUpDisplay::setRemainingBonusTime((bonusRemainingTime / 1000) + 1); // Convert time to seconds, add one more second to compensate for integer computation rounding
+		
+		// Come back when the displayed seconds count changes
+		_bonusTimerId = TimerManager::schedule((bonusRemainingTime % 1000) + 1, _bonusTimerCallback, this);
+		return;
+	}
+	
+	// Disable bonus time displaying
+	HeadUpDisplay::setRemainingBonusTime(0);
+	
+	// Restore player default attributes
+	_timeBetweenShots = CONFIGURATION_GAMEPLAY_PLAYER_DEFAULT_PRIMARY_FIRE_TIME_BETWEEN_TWO_SHOTS;
+	_updateReloadingTimer();
+	_currentActiveBonus = BONUS_NONE;
+	
+	// Restore default player skin
+	_pointerTextures[DIRECTION_UP] = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_UP);
+	_pointerTextures[DIRECTION_DOWN] = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_DOWN);
+	_pointerTextures[DIRECTION_LEFT] = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_LEFT);
+	_pointerTextures[DIRECTION_RIGHT] = TextureManager::getTextureFromId(TextureManager::TEXTURE_ID_PLAYER_FACING_RIGHT);
+}
+
+void PlayerFightingEntity::_secondaryFireReloadingTimerCallback(void *pointerParameter)
+{
+	PlayerFightingEntity *pointerEntity = (PlayerFightingEntity *) pointerParameter;
+	
+	pointerEntity->_isSecondaryShootReloadingTimeElapsed = true;
+	pointerEntity->_secondaryFireReloadingTimerId = TimerManager::TIMER_ID_NONE;
+	pointerEntity->_updateMortarHudState();
+}
+
+void PlayerFightingEntity::_bonusTimerCallback(void *pointerParameter)
+{
+	PlayerFightingEntity *pointerEntity = (PlayerFightingEntity *) pointerParameter;
+	
+	pointerEntity->_bonusTimerId = TimerManager::TIMER_ID_NONE;
+	pointerEntity->_updateBonus();
+}
@@ -2,13 +2,18 @@
  * See Renderer.hpp for description.
  * @author Adrien RICCIARDI
  */
+#include <algorithm>
 #include <cassert>
 #include <Configuration.hpp>
 #include <cstdlib>
+#include <cstring>
 #include <FileManager.hpp>
+#include <functional>
 #include <Log.hpp>
 #include <Renderer.hpp>
 #include <SDL2/SDL.h>
+#include <string>
+#include <vector>
 #ifdef __APPLE__
 	#include <SDL2_ttf/SDL_ttf.h>
 #else
@@ -20,19 +25,175 @@
 
 namespace Renderer
 {
+	/** All kinds of drawings a frame snapshot can contain. */
+	typedef enum
+	{
+		DRAWING_COMMAND_TYPE_TEXTURE,
+		DRAWING_COMMAND_TYPE_RECTANGLE,
+		DRAWING_COMMAND_TYPE_TEXT
+	} DrawingCommandType;
+
+	/** Everything needed to draw something without accessing the game objects. */
+	typedef struct
+	{
+		DrawingCommandType type; //!< What to draw.
+		LayerId layerId; //!< The layer the drawing belongs to.
+		SDL_Texture *pointerTargetTexture; //!< The texture to draw to, it is NULL when drawing to the display.
+		SDL_Texture *pointerTexture; //!< The texture to copy (texture commands only).
+		SDL_Rect sourceRectangle; //!< The texture part to copy (texture commands only).
+		SDL_Rect destinationRectangle; //!< Where to draw on the display (text commands only use the coordinates, the X coordinate is -1 when the text must be centered).
+		bool isSourceRectangleUsed; //!< Set to false to copy the whole texture.
+		bool isDestinationRectangleUsed; //!< Set to false to stretch the texture over the whole display.
+		SDL_Color color; //!< The outline color (rectangle commands only).
+		TextColorId textColorId; //!< The text color (text commands only).
+		FontSizeId fontSizeId; //!< The text font size (text commands only).
+		int textOffset; //!< Where the string starts in the frame snapshot texts (text commands only).
+	} DrawingCommand;
+
+	/** Everything the render thread needs to draw a whole frame, so the game can go on updating while the frame is drawn. */
+	typedef struct
+	{
+		std::vector<DrawingCommand> drawingCommands; //!< All drawings in displaying order.
+		std::string texts; //!< The strings of all text commands, each one is terminated by a zero.
+		std::vector<SDL_Texture *> texturesToDestroy; //!< The textures the game stopped using, they are destroyed once the frame is drawn because the previous frames may still display them.
+	} FrameSnapshot;
+
+	/** The first character stored in the glyph atlas. */
+	#define GLYPH_FIRST_CHARACTER ' '
+	/** How many characters are stored in the glyph atlas for each font size and color (all printable ASCII characters). */
+	#define GLYPHS_COUNT ('~' - GLYPH_FIRST_CHARACTER + 1)
+
+	/** A character of the glyph atlas. */
+	typedef struct
+	{
+		SDL_Rect atlasRectangle; //!< Where the character picture is in the glyph atlas, the rectangle is empty if the character has no visible pixel.
+		int advance; //!< How many pixels separate the character left side from the next character one.
+	} Glyph;
+
+	/** A function run by the render thread on behalf of another thread.
+	* @param pointerParameter The parameter given to _runOnRenderThread().
+	*/
+	typedef void (*RenderThreadRequestFunction)(void *pointerParameter);
+
+	/** The parameters of a texture creation request. */
+	typedef struct
+	{
+		SDL_Surface *pointerSurface; //!< The surface to convert.
+		SDL_Texture *pointerTexture; //!< On output, contain the created texture or NULL if an error occurred.
+	} TextureCreationRequest;
+
+	/** The parameters of a target texture creation request. */
+	typedef struct
+	{
+		int width; //!< The texture width in pixels.
+		int height; //!< The texture height in pixels.
+		SDL_Texture *pointerTexture; //!< On output, contain the created texture or NULL if an error occurred.
+	} TargetTextureCreationRequest;
+
+	/** The parameters of a text rendering request. */
+	typedef struct
+	{
+		const char *pointerStringText; //!< The string to render.
+		TextColorId colorId; //!< The text color.
+		FontSizeId fontSizeId; //!< The font size.
+		SDL_Texture *pointerTexture; //!< On output, contain the rendered text or NULL if an error occurred.
+	} TextRenderingRequest;
+
+	/** Some platforms (like macOS) only allow the main thread to draw to a window, the frames are then drawn by the main thread as soon as they are recorded. */
+	#ifdef __APPLE__
+		static const bool _isRenderThreadEnabled = false;
+	#else
+		static const bool _isRenderThreadEnabled = true;
+	#endif
+
 	/** The game window. */
 	static SDL_Window *_pointerMainWindow;
+	/** The renderer used to render to the game window, only the render thread can use it. */
+	static SDL_Renderer *_pointerRenderer;
 
 	/** The fonts used to draw text. */
 	static TTF_Font *_pointerFonts[FONT_SIZE_IDS_COUNT];
 	/** All available text colors. */
 	static SDL_Color _textColors[TEXT_COLOR_IDS_COUNT];
 	
-	/** Store the time in milliseconds when a frame creation started. */
-	static unsigned int _frameStartingTime = 0;
+	/** How to synchronize the frames with the display refresh. */
+	static VSyncMode _vsyncMode;
+	/** The minimum duration of a frame in performance counter ticks, 0 if the frame rate is not limited. */
+	static Uint64 _framePeriodCounterTicks = 0;
+	/** The performance counter value when the next frame can start. */
+	static Uint64 _nextFrameStartingCounterValue = 0;
+	/** How many performance counter ticks the frame rate limiter spins before the next frame time. */
+	static Uint64 _frameLimiterSpinCounterTicks;
 
-	// Public variable, documentation is in the header file
-	SDL_Renderer *pointerRenderer;
+	/** The frame snapshots, one is being recorded by the game, one is waiting to be drawn and the last one is being drawn by the render thread. */
+	static FrameSnapshot _frameSnapshots[3];
+	/** The snapshot the game is recording to. */
+	static FrameSnapshot *_pointerRecordedFrameSnapshot = &_frameSnapshots[0];
+	/** The most recently recorded snapshot. */
+	static FrameSnapshot *_pointerPendingFrameSnapshot = &_frameSnapshots[1];
+	/** The snapshot owned by the render thread. */
+	static FrameSnapshot *_pointerDrawnFrameSnapshot = &_frameSnapshots[2];
+	/** Tell whether the pending snapshot has not been drawn yet. */
+	static bool _isFrameSnapshotPending = false;
+
+	/** The layer the game is recording to. */
+	static LayerId _currentLayerId = LAYER_ID_SCENE;
+	/** The texture the game is recording to, NULL when recording to the display. */
+	static SDL_Texture *_pointerCurrentTargetTexture = NULL;
+
+	/** All characters of all font sizes and colors, rendered to a single texture so the texts cost no rendering nor texture upload when they change (only the render thread uses it). */
+	static SDL_Texture *_pointerGlyphAtlasTexture = NULL;
+	/** Where each character of each font size and color is in the glyph atlas. */
+	static Glyph _glyphs[FONT_SIZE_IDS_COUNT][TEXT_COLOR_IDS_COUNT][GLYPHS_COUNT];
+
+	/** The game world is drawn to the top left part of this texture when it is drawn at a lower resolution than the display, NULL if the world is always drawn to the display (only the render thread uses it). */
+	static SDL_Texture *_pointerWorldTexture = NULL;
+	/** The resolution the game world is drawn at, in percentage of the display resolution. */
+	static int _renderScalePercentage = 100;
+	/** Tell whether the render scale is adjusted according to the frames presenting times. */
+	static bool _isRenderScaleAutomatic = false;
+	/** A frame presented more than this amount of performance counter ticks after the previous one missed a display refresh. */
+	static Uint64 _lateFrameCounterTicks;
+	/** The performance counter value when the previous frame was presented. */
+	static Uint64 _previousFramePresentingCounterValue = 0;
+	/** How many frames were presented since the render scale was last adjusted. */
+	static int _measuredFramesCount = 0;
+	/** How many of the measured frames were late. */
+	static int _lateFramesCount = 0;
+	/** How many successive measurements had no late frame. */
+	static int _inTimeMeasurementsCount = 0;
+	/** Tell whether the render thread waited for the game to record the frame being drawn, the frame is then late because of the game rather than because of the rendering. */
+	static bool _isFrameSnapshotWaited = false;
+
+	#if SDL_VERSION_ATLEAST(2, 0, 18)
+		/** The texture all batched sprites are copied from (only the render thread uses the batch). */
+		static SDL_Texture *_pointerSpriteBatchTexture = NULL;
+		/** The batch texture width in pixels. */
+		static float _spriteBatchTextureWidth;
+		/** The batch texture height in pixels. */
+		static float _spriteBatchTextureHeight;
+		/** The corners of all batched sprites, 4 per sprite. */
+		static std::vector<SDL_Vertex> _spriteBatchVertices;
+		/** The two triangles of each batched sprite, 6 vertex indexes per sprite. */
+		static std::vector<int> _spriteBatchIndexes;
+	#endif
+
+	/** The thread drawing the frame snapshots. */
+	static SDL_Thread *_pointerRenderThread = NULL;
+	/** Protect the frame snapshots exchange and the requests. */
+	static SDL_mutex *_pointerMutex;
+	/** Wake the render thread up when a frame snapshot or a request is available. */
+	static SDL_cond *_pointerRenderThreadCondition;
+	/** Wake the requesting thread up when the render thread has served its request. */
+	static SDL_cond *_pointerRequestFinishedCondition;
+	/** Wake the game up when the render thread has taken the pending frame snapshot. */
+	static SDL_cond *_pointerFrameSnapshotTakenCondition;
+	/** The function the render thread must run, NULL if there is no request. */
+	static RenderThreadRequestFunction _pointerRequestFunction = NULL;
+	/** The request function parameter. */
+	static void *_pointerRequestParameter;
+	/** Tell the render thread it must exit. */
+	static bool _isTerminationRequested = false;
 
 	// Public variables, documentation is in the header file
 	int displayX;
@@ -42,10 +203,749 @@ namespace Renderer
 	int displayWidth;
 	int displayHeight;
 
-	int initialize(bool isFullScreenEnabled)
+	// Public variable, documentation is in the header file
+	float interpolationFactor = 1;
+
+	// Public variable, documentation is in the header file
+	bool isHeadlessModeEnabled = false;
+
+	/** Render a text to a texture (this is called by the render thread).
+	* @param pointerStringText The string to render.
+	* @param colorId The text color.
+	* @param fontSizeId The font size.
+	* @return The texture containing the text,
+	* @return NULL if an error occurred (the error is logged).
+	*/
+	static SDL_Texture *_renderTextToTexture(const char *pointerStringText, TextColorId colorId, FontSizeId fontSizeId)
+	{
+		// Render the text
+		SDL_Surface *pointerSurface = TTF_RenderText_Blended(_pointerFonts[fontSizeId], pointerStringText, _textColors[colorId]);
+		if (pointerSurface == NULL)
+		{
+			LOG_ERROR("Failed to render the text to a surface (%s).", TTF_GetError());
+			return NULL;
+		}
+		
+		// Convert it to a texture to be able to display it
+		SDL_Texture *pointerTexture = SDL_CreateTextureFromSurface(_pointerRenderer, pointerSurface);
+		SDL_FreeSurface(pointerSurface);
+		if (pointerTexture == NULL) LOG_ERROR("Failed to convert the surface to a texture (%s).", SDL_GetError());
+		
+		return pointerTexture;
+	}
+
+	/** Create the window renderer and determine the display size (this is called by the render thread).
+	* @param pointerIsFullScreenEnabled Point to a boolean telling whether the window is in full screen mode.
+	* @note The renderer pointer is NULL if an error occurred.
+	*/
+	static void _createRenderer(void *pointerIsFullScreenEnabled)
 	{
-		unsigned int flags;
 		SDL_RendererInfo rendererInformation;
+		Uint32 flags = SDL_RENDERER_ACCELERATED;
+		
+		if (_vsyncMode != VSYNC_MODE_OFF) flags |= SDL_RENDERER_PRESENTVSYNC;
+		_pointerRenderer = SDL_CreateRenderer(_pointerMainWindow, -1, flags);
+		if (_pointerRenderer == NULL)
+		{
+			LOG_ERROR("Failed to create the main renderer (%s).", SDL_GetError());
+			return;
+		}
+		
+		// Display rendering driver name
+		if (SDL_GetRendererInfo(_pointerRenderer, &rendererInformation) != 0) rendererInformation.name = "unknown";
+		LOG_DEBUG("Rendering driver : %s.", rendererInformation.name);
+		
+		// Only OpenGL allows to change the swap interval, it can be done here because the renderer OpenGL context is current in the thread that created the renderer
+		if (_vsyncMode == VSYNC_MODE_ADAPTIVE)
+		{
+			if ((strncmp(rendererInformation.name, "opengl", 6) != 0) || (SDL_GL_SetSwapInterval(-1) != 0)) LOG_INFORMATION("Adaptive VSync is not supported by the \"%s\" rendering driver, using VSync instead.", rendererInformation.name);
+		}
+		
+		// Set display size according to selected mode
+		if (*static_cast<bool *>(pointerIsFullScreenEnabled))
+		{
+			if (SDL_GetRendererOutputSize(_pointerRenderer, &displayWidth, &displayHeight) != 0)
+			{
+				LOG_ERROR("Failed to get renderer output size (%s).", SDL_GetError());
+				SDL_DestroyRenderer(_pointerRenderer);
+				_pointerRenderer = NULL;
+			}
+		}
+		else
+		{
+			displayWidth = CONFIGURATION_DISPLAY_WIDTH;
+			displayHeight = CONFIGURATION_DISPLAY_HEIGHT;
+		}
+	}
+
+	/** Destroy the window renderer and all its textures (this is called by the render thread). */
+	static void _destroyRenderer()
+	{
+		if (_pointerRenderer == NULL) return;
+		
+		// The glyph atlas and the world texture are destroyed with the renderer
+		_pointerGlyphAtlasTexture = NULL;
+		_pointerWorldTexture = NULL;
+		
+		SDL_DestroyRenderer(_pointerRenderer);
+		_pointerRenderer = NULL;
+	}
+
+	/** Serve a texture creation request (this is called by the render thread).
+	* @param pointerRequest The request parameters.
+	*/
+	static void _createTextureFromSurface(void *pointerRequest)
+	{
+		TextureCreationRequest *pointerTextureCreationRequest = static_cast<TextureCreationRequest *>(pointerRequest);
+		
+		pointerTextureCreationRequest->pointerTexture = SDL_CreateTextureFromSurface(_pointerRenderer, pointerTextureCreationRequest->pointerSurface);
+		if (pointerTextureCreationRequest->pointerTexture == NULL) LOG_ERROR("Failed to convert the surface to a texture (%s).", SDL_GetError());
+	}
+
+	/** Render all characters of all font sizes and colors to the glyph atlas (this is called by the render thread).
+	* @param pointerResult On output, contain 0 if the atlas was created or -1 if an error occurred.
+	*/
+	static void _createGlyphAtlas(void *pointerResult)
+	{
+		SDL_Surface *pointerGlyphsSurfaces[FONT_SIZE_IDS_COUNT][TEXT_COLOR_IDS_COUNT][GLYPHS_COUNT], *pointerSurface, *pointerAtlasSurface = NULL;
+		int *pointerReturnValue = static_cast<int *>(pointerResult), fontSizeId, colorId, i, advance, x = 0, y = 0, rowHeight = 0, atlasWidth = 0;
+		Glyph *pointerGlyph;
+		SDL_Rect destinationRectangle;
+		
+		*pointerReturnValue = -1;
+		memset(pointerGlyphsSurfaces, 0, sizeof(pointerGlyphsSurfaces));
+		
+		// Render each character and put it after the previous one, starting a new row when the atlas width is reached
+		for (fontSizeId = 0; fontSizeId < FONT_SIZE_IDS_COUNT; fontSizeId++)
+		{
+			for (colorId = 0; colorId < TEXT_COLOR_IDS_COUNT; colorId++)
+			{
+				for (i = 0; i < GLYPHS_COUNT; i++)
+				{
+					pointerGlyph = &_glyphs[fontSizeId][colorId][i];
+					if (TTF_GlyphMetrics(_pointerFonts[fontSizeId], GLYPH_FIRST_CHARACTER + i, NULL, NULL, NULL, NULL, &advance) != 0)
+					{
+						LOG_ERROR("Failed to get the metrics of the character '%c' (%s).", GLYPH_FIRST_CHARACTER + i, TTF_GetError());
+						goto Exit;
+					}
+					pointerGlyph->advance = advance;
+					
+					// Some characters (like space) have no visible pixel, so they can't be rendered
+					pointerSurface = TTF_RenderGlyph_Blended(_pointerFonts[fontSizeId], GLYPH_FIRST_CHARACTER + i, _textColors[colorId]);
+					pointerGlyphsSurfaces[fontSizeId][colorId][i] = pointerSurface;
+					if (pointerSurface == NULL)
+					{
+						memset(&pointerGlyph->atlasRectangle, 0, sizeof(pointerGlyph->atlasRectangle));
+						continue;
+					}
+					
+					if (x + pointerSurface->w > CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SIZE)
+					{
+						x = 0;
+						y += rowHeight + CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING;
+						rowHeight = 0;
+					}
+					pointerGlyph->atlasRectangle.x = x;
+					pointerGlyph->atlasRectangle.y = y;
+					pointerGlyph->atlasRectangle.w = pointerSurface->w;
+					pointerGlyph->atlasRectangle.h = pointerSurface->h;
+					
+					x += pointerSurface->w + CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING;
+					if (x - CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING > atlasWidth) atlasWidth = x - CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING;
+					if (pointerSurface->h > rowHeight) rowHeight = pointerSurface->h;
+				}
+			}
+		}
+		if (y + rowHeight > CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SIZE)
+		{
+			LOG_ERROR("The glyph atlas needs %d pixels height, which is more than a texture atlas size.", y + rowHeight);
+			goto Exit;
+		}
+		
+		// Copy the characters to the atlas (a new surface is fully transparent)
+		pointerAtlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, y + rowHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+		if (pointerAtlasSurface == NULL)
+		{
+			LOG_ERROR("Failed to create the glyph atlas surface (%s).", SDL_GetError());
+			goto Exit;
+		}
+		for (fontSizeId = 0; fontSizeId < FONT_SIZE_IDS_COUNT; fontSizeId++)
+		{
+			for (colorId = 0; colorId < TEXT_COLOR_IDS_COUNT; colorId++)
+			{
+				for (i = 0; i < GLYPHS_COUNT; i++)
+				{
+					pointerSurface = pointerGlyphsSurfaces[fontSizeId][colorId][i];
+					if (pointerSurface == NULL) continue;
+					
+					SDL_SetSurfaceBlendMode(pointerSurface, SDL_BLENDMODE_NONE);
+					destinationRectangle = _glyphs[fontSizeId][colorId][i].atlasRectangle; // The blit function overwrites the rectangle
+					if (SDL_BlitSurface(pointerSurface, NULL, pointerAtlasSurface, &destinationRectangle) != 0)
+					{
+						LOG_ERROR("Failed to copy the character '%c' to the glyph atlas (%s).", GLYPH_FIRST_CHARACTER + i, SDL_GetError());
+						goto Exit;
+					}
+				}
+			}
+		}
+		
+		_pointerGlyphAtlasTexture = SDL_CreateTextureFromSurface(_pointerRenderer, pointerAtlasSurface);
+		if (_pointerGlyphAtlasTexture == NULL)
+		{
+			LOG_ERROR("Failed to convert the glyph atlas surface to a texture (%s).", SDL_GetError());
+			goto Exit;
+		}
+		LOG_DEBUG("Created glyph atlas. Width : %d, height : %d.", atlasWidth, y + rowHeight);
+		*pointerReturnValue = 0;
+		
+	Exit:
+		for (fontSizeId = 0; fontSizeId < FONT_SIZE_IDS_COUNT; fontSizeId++)
+		{
+			for (colorId = 0; colorId < TEXT_COLOR_IDS_COUNT; colorId++)
+			{
+				for (i = 0; i < GLYPHS_COUNT; i++) SDL_FreeSurface(pointerGlyphsSurfaces[fontSizeId][colorId][i]);
+			}
+		}
+		SDL_FreeSurface(pointerAtlasSurface);
+	}
+
+	/** Serve a target texture creation request (this is called by the render thread).
+	* @param pointerRequest The request parameters.
+	*/
+	static void _createTargetTexture(void *pointerRequest)
+	{
+		TargetTextureCreationRequest *pointerTargetTextureCreationRequest = static_cast<TargetTextureCreationRequest *>(pointerRequest);
+		
+		pointerTargetTextureCreationRequest->pointerTexture = NULL;
+		if (!SDL_RenderTargetSupported(_pointerRenderer))
+		{
+			LOG_INFORMATION("The renderer can't draw to textures.");
+			return;
+		}
+		
+		SDL_Texture *pointerTexture = SDL_CreateTexture(_pointerRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, pointerTargetTextureCreationRequest->width, pointerTargetTextureCreationRequest->height);
+		if (pointerTexture == NULL)
+		{
+			LOG_ERROR("Failed to create a %dx%d target texture (%s).", pointerTargetTextureCreationRequest->width, pointerTargetTextureCreationRequest->height, SDL_GetError());
+			return;
+		}
+		
+		// Keep the transparency of the drawings when the texture is displayed
+		if (SDL_SetTextureBlendMode(pointerTexture, SDL_BLENDMODE_BLEND) != 0)
+		{
+			LOG_ERROR("Failed to enable the blending of the target texture (%s).", SDL_GetError());
+			SDL_DestroyTexture(pointerTexture);
+			return;
+		}
+		pointerTargetTextureCreationRequest->pointerTexture = pointerTexture;
+	}
+
+	/** Create the texture the game world is drawn to at a lower resolution (this is called by the render thread).
+	* @param pointerResult On output, contain 0 if the texture was created or -1 if the world must be drawn at the display resolution.
+	*/
+	static void _createWorldTexture(void *pointerResult)
+	{
+		TargetTextureCreationRequest request;
+		int *pointerReturnValue = static_cast<int *>(pointerResult);
+		
+		// The texture has the display size, so the render scale can change without creating another texture
+		*pointerReturnValue = -1;
+		request.width = displayWidth;
+		request.height = displayHeight;
+		_createTargetTexture(&request);
+		if (request.pointerTexture == NULL) return;
+		
+		// The world covers the whole display, so it does not need to be blended, and it is smoothed when it is stretched
+		SDL_SetTextureBlendMode(request.pointerTexture, SDL_BLENDMODE_NONE);
+		#if SDL_VERSION_ATLEAST(2, 0, 12)
+			if (SDL_SetTextureScaleMode(request.pointerTexture, SDL_ScaleModeLinear) != 0) LOG_INFORMATION("Failed to smooth the stretched game world (%s).", SDL_GetError());
+		#endif
+		_pointerWorldTexture = request.pointerTexture;
+		*pointerReturnValue = 0;
+	}
+
+	/** Serve a text rendering request (this is called by the render thread).
+	* @param pointerRequest The request parameters.
+	*/
+	static void _renderTextToTextureRequest(void *pointerRequest)
+	{
+		TextRenderingRequest *pointerTextRenderingRequest = static_cast<TextRenderingRequest *>(pointerRequest);
+		pointerTextRenderingRequest->pointerTexture = _renderTextToTexture(pointerTextRenderingRequest->pointerStringText, pointerTextRenderingRequest->colorId, pointerTextRenderingRequest->fontSizeId);
+	}
+
+	/** Draw all batched sprites with a single call, then start a new batch (this is called by the render thread). */
+	static void _flushSpriteBatch()
+	{
+		#if SDL_VERSION_ATLEAST(2, 0, 18)
+			if (!_spriteBatchVertices.empty())
+			{
+				if (SDL_RenderGeometry(_pointerRenderer, _pointerSpriteBatchTexture, &_spriteBatchVertices[0], _spriteBatchVertices.size(), &_spriteBatchIndexes[0], _spriteBatchIndexes.size()) != 0) LOG_ERROR("Failed to draw %d batched sprites (%s).", (int) _spriteBatchVertices.size() / 4, SDL_GetError());
+				_spriteBatchVertices.clear();
+				_spriteBatchIndexes.clear();
+			}
+			
+			// The texture may be destroyed at the end of the frame and another one may be created at the same address
+			_pointerSpriteBatchTexture = NULL;
+		#endif
+	}
+
+	/** Draw a part of a texture, the sprites copied from the same texture are batched together so a whole level is drawn with a few calls when the textures come from an atlas (this is called by the render thread).
+	* @param pointerTexture The texture to copy from.
+	* @param pointerSourceRectangle The texture part to copy, set to NULL to copy the whole texture.
+	* @param pointerDestinationRectangle The display area to draw to.
+	*/
+	static void _drawSprite(SDL_Texture *pointerTexture, const SDL_Rect *pointerSourceRectangle, const SDL_Rect *pointerDestinationRectangle)
+	{
+		#if SDL_VERSION_ATLEAST(2, 0, 18)
+			// A batch can only use one texture
+			if (pointerTexture != _pointerSpriteBatchTexture)
+			{
+				_flushSpriteBatch();
+				
+				int width, height;
+				if (SDL_QueryTexture(pointerTexture, NULL, NULL, &width, &height) != 0)
+				{
+					LOG_ERROR("Failed to query information about the SDL texture (SDL texture pointer : %p), shutting down (%s).", pointerTexture, SDL_GetError());
+					exit(-1);
+				}
+				_pointerSpriteBatchTexture = pointerTexture;
+				_spriteBatchTextureWidth = width;
+				_spriteBatchTextureHeight = height;
+			}
+			
+			// Get the texture coordinates, from 0 to 1
+			float left, top, right, bottom;
+			if (pointerSourceRectangle != NULL)
+			{
+				left = pointerSourceRectangle->x / _spriteBatchTextureWidth;
+				top = pointerSourceRectangle->y / _spriteBatchTextureHeight;
+				right = (pointerSourceRectangle->x + pointerSourceRectangle->w) / _spriteBatchTextureWidth;
+				bottom = (pointerSourceRectangle->y + pointerSourceRectangle->h) / _spriteBatchTextureHeight;
+			}
+			else
+			{
+				left = 0;
+				top = 0;
+				right = 1;
+				bottom = 1;
+			}
+			
+			// Append the sprite corners, clockwise from the top left one
+			int firstVertexIndex = _spriteBatchVertices.size();
+			SDL_Vertex vertex;
+			vertex.color.r = 255;
+			vertex.color.g = 255;
+			vertex.color.b = 255;
+			vertex.color.a = 255;
+			vertex.position.x = pointerDestinationRectangle->x;
+			vertex.position.y = pointerDestinationRectangle->y;
+			vertex.tex_coord.x = left;
+			vertex.tex_coord.y = top;
+			_spriteBatchVertices.push_back(vertex);
+			vertex.position.x = pointerDestinationRectangle->x + pointerDestinationRectangle->w;
+			vertex.tex_coord.x = right;
+			_spriteBatchVertices.push_back(vertex);
+			vertex.position.y = pointerDestinationRectangle->y + pointerDestinationRectangle->h;
+			vertex.tex_coord.y = bottom;
+			_spriteBatchVertices.push_back(vertex);
+			vertex.position.x = pointerDestinationRectangle->x;
+			vertex.tex_coord.x = left;
+			_spriteBatchVertices.push_back(vertex);
+			
+			// Split the sprite in two triangles
+			_spriteBatchIndexes.push_back(firstVertexIndex);
+			_spriteBatchIndexes.push_back(firstVertexIndex + 1);
+			_spriteBatchIndexes.push_back(firstVertexIndex + 2);
+			_spriteBatchIndexes.push_back(firstVertexIndex);
+			_spriteBatchIndexes.push_back(firstVertexIndex + 2);
+			_spriteBatchIndexes.push_back(firstVertexIndex + 3);
+		#else
+			// Older SDL versions can only draw the sprites one by one
+			SDL_RenderCopy(_pointerRenderer, pointerTexture, pointerSourceRectangle, pointerDestinationRectangle);
+		#endif
+	}
+
+	/** Draw a texture command (this is called by the render thread).
+	* @param pointerDrawingCommand The texture command.
+	* @param isWorldTextureSelected Set to true when drawing to the world texture, of which only the top left part is displayed.
+	*/
+	static void _drawTexture(DrawingCommand *pointerDrawingCommand, bool isWorldTextureSelected)
+	{
+		// The stretched textures are seldom used, the renderer knows the display size better
+		if (!pointerDrawingCommand->isDestinationRectangleUsed)
+		{
+			_flushSpriteBatch();
+			
+			// Stretch the texture over the display area only, the render scale then shrinks it to the world texture part that is displayed
+			SDL_Rect displayRectangle = {0, 0, displayWidth, displayHeight};
+			SDL_RenderCopy(_pointerRenderer, pointerDrawingCommand->pointerTexture, pointerDrawingCommand->isSourceRectangleUsed ? &pointerDrawingCommand->sourceRectangle : NULL, isWorldTextureSelected ? &displayRectangle : NULL);
+			return;
+		}
+		
+		_drawSprite(pointerDrawingCommand->pointerTexture, pointerDrawingCommand->isSourceRectangleUsed ? &pointerDrawingCommand->sourceRectangle : NULL, &pointerDrawingCommand->destinationRectangle);
+	}
+
+	/** Get the glyph atlas character matching a string character.
+	* @param pointerDrawingCommand The text command telling the font size and color.
+	* @param character The string character, the characters missing from the glyph atlas are displayed as a question mark.
+	* @return The glyph atlas character.
+	*/
+	static inline Glyph *_getGlyph(DrawingCommand *pointerDrawingCommand, char character)
+	{
+		int glyphIndex = (unsigned char) character - GLYPH_FIRST_CHARACTER;
+		if ((glyphIndex < 0) || (glyphIndex >= GLYPHS_COUNT)) glyphIndex = '?' - GLYPH_FIRST_CHARACTER;
+		
+		return &_glyphs[pointerDrawingCommand->fontSizeId][pointerDrawingCommand->textColorId][glyphIndex];
+	}
+
+	/** Draw a text command character by character from the glyph atlas, the characters are batched like the sprites (this is called by the render thread).
+	* @param pointerDrawingCommand The text command.
+	* @param pointerStringText The string to display.
+	*/
+	static void _drawText(DrawingCommand *pointerDrawingCommand, const char *pointerStringText)
+	{
+		const char *pointerCharacter;
+		Glyph *pointerGlyph;
+		SDL_Rect destinationRectangle;
+		int textWidth = 0;
+		
+		// Center the text if needed
+		if (pointerDrawingCommand->destinationRectangle.x == -1)
+		{
+			for (pointerCharacter = pointerStringText; *pointerCharacter != 0; pointerCharacter++) textWidth += _getGlyph(pointerDrawingCommand, *pointerCharacter)->advance;
+			destinationRectangle.x = (displayWidth - textWidth) / 2;
+		}
+		else destinationRectangle.x = pointerDrawingCommand->destinationRectangle.x;
+		destinationRectangle.y = pointerDrawingCommand->destinationRectangle.y;
+		
+		// Display each character after the previous one
+		for (pointerCharacter = pointerStringText; *pointerCharacter != 0; pointerCharacter++)
+		{
+			pointerGlyph = _getGlyph(pointerDrawingCommand, *pointerCharacter);
+			if (pointerGlyph->atlasRectangle.w > 0)
+			{
+				destinationRectangle.w = pointerGlyph->atlasRectangle.w;
+				destinationRectangle.h = pointerGlyph->atlasRectangle.h;
+				_drawSprite(_pointerGlyphAtlasTexture, &pointerGlyph->atlasRectangle, &destinationRectangle);
+			}
+			destinationRectangle.x += pointerGlyph->advance;
+		}
+	}
+
+	/** Tell whether a drawing must be drawn before another one. The drawings are sorted by target texture, then by layer, then by kind and texture, so the sprites batch contains as many sprites as possible.
+	* @param firstDrawingCommand The first drawing.
+	* @param secondDrawingCommand The second drawing.
+	* @return true if the first drawing must be drawn before the second one,
+	* @return false if the second drawing must be drawn first or if their order does not matter.
+	*/
+	static bool _isDrawingCommandDrawnBefore(const DrawingCommand &firstDrawingCommand, const DrawingCommand &secondDrawingCommand)
+	{
+		// The textures are drawn first, so the display can show them
+		if (firstDrawingCommand.pointerTargetTexture != secondDrawingCommand.pointerTargetTexture)
+		{
+			if (firstDrawingCommand.pointerTargetTexture == NULL) return false;
+			if (secondDrawingCommand.pointerTargetTexture == NULL) return true;
+			return std::less<SDL_Texture *>()(firstDrawingCommand.pointerTargetTexture, secondDrawingCommand.pointerTargetTexture);
+		}
+		
+		if (firstDrawingCommand.layerId != secondDrawingCommand.layerId) return firstDrawingCommand.layerId < secondDrawingCommand.layerId;
+		if (firstDrawingCommand.type != secondDrawingCommand.type) return firstDrawingCommand.type < secondDrawingCommand.type;
+		if (firstDrawingCommand.type != DRAWING_COMMAND_TYPE_TEXTURE) return false; // Keep the recording order
+		return std::less<SDL_Texture *>()(firstDrawingCommand.pointerTexture, secondDrawingCommand.pointerTexture);
+	}
+
+	/** Start drawing to a texture or to the display, which is cleaned first (this is called by the render thread).
+	* @param pointerTargetTexture The texture to draw to, set to NULL to draw to the display.
+	*/
+	static void _selectTargetTexture(SDL_Texture *pointerTargetTexture)
+	{
+		_flushSpriteBatch();
+		if (SDL_SetRenderTarget(_pointerRenderer, pointerTargetTexture) != 0) LOG_ERROR("Failed to select the rendering target (SDL texture pointer : %p, %s).", pointerTargetTexture, SDL_GetError());
+		
+		// A texture is cleaned to transparent, so only its drawings are visible when it is displayed
+		if (pointerTargetTexture == NULL) SDL_SetRenderDrawColor(_pointerRenderer, 0, 0, 0, 255);
+		else SDL_SetRenderDrawColor(_pointerRenderer, 0, 0, 0, 0);
+		SDL_RenderClear(_pointerRenderer);
+		SDL_SetRenderDrawColor(_pointerRenderer, 0, 0, 0, 255);
+	}
+
+	/** Start drawing to the display, which is cleaned first (this is called by the render thread).
+	* @param isWorldTextureDrawn Set to true to stretch the world texture over the display.
+	*/
+	static void _selectDisplay(bool isWorldTextureDrawn)
+	{
+		_selectTargetTexture(NULL);
+		if (!isWorldTextureDrawn) return;
+		
+		SDL_Rect sourceRectangle = {0, 0, (displayWidth * _renderScalePercentage) / 100, (displayHeight * _renderScalePercentage) / 100};
+		if (SDL_RenderCopy(_pointerRenderer, _pointerWorldTexture, &sourceRectangle, NULL) != 0) LOG_ERROR("Failed to stretch the game world over the display (%s).", SDL_GetError());
+	}
+
+	/** Measure how many frames miss the display refresh, then lower the game world resolution when too many frames are late, or raise it when the frames stay in time (this is called by the render thread after each frame is presented). */
+	static void _adjustRenderScale()
+	{
+		Uint64 performanceCounterValue = SDL_GetPerformanceCounter();
+		
+		// A frame recorded late by the game would not be in time with a lower resolution
+		if ((_previousFramePresentingCounterValue != 0) && !_isFrameSnapshotWaited && (performanceCounterValue - _previousFramePresentingCounterValue > _lateFrameCounterTicks)) _lateFramesCount++;
+		_previousFramePresentingCounterValue = performanceCounterValue;
+		_measuredFramesCount++;
+		if (_measuredFramesCount < CONFIGURATION_DISPLAY_RENDER_SCALE_MEASURED_FRAMES_COUNT) return;
+		
+		// Lower the resolution as soon as a few frames are late, but raise it only after a long time without late frame, so the resolution does not change back and forth
+		if (_lateFramesCount == 0) _inTimeMeasurementsCount++;
+		else _inTimeMeasurementsCount = 0;
+		if (_lateFramesCount * 100 > _measuredFramesCount * CONFIGURATION_DISPLAY_RENDER_SCALE_MAXIMUM_LATE_FRAMES_PERCENTAGE)
+		{
+			if (_renderScalePercentage > CONFIGURATION_DISPLAY_RENDER_SCALE_MINIMUM_PERCENTAGE)
+			{
+				_renderScalePercentage -= CONFIGURATION_DISPLAY_RENDER_SCALE_STEP_PERCENTAGE;
+				if (_renderScalePercentage < CONFIGURATION_DISPLAY_RENDER_SCALE_MINIMUM_PERCENTAGE) _renderScalePercentage = CONFIGURATION_DISPLAY_RENDER_SCALE_MINIMUM_PERCENTAGE;
+				LOG_DEBUG("%d late frames among %d, lowering the render scale to %d%%.", _lateFramesCount, _measuredFramesCount, _renderScalePercentage);
+			}
+		}
+		else if ((_inTimeMeasurementsCount >= CONFIGURATION_DISPLAY_RENDER_SCALE_RAISING_MEASUREMENTS_COUNT) && (_renderScalePercentage < 100))
+		{
+			_renderScalePercentage += CONFIGURATION_DISPLAY_RENDER_SCALE_STEP_PERCENTAGE;
+			if (_renderScalePercentage > 100) _renderScalePercentage = 100;
+			_inTimeMeasurementsCount = 0;
+			LOG_DEBUG("No late frame among the %d last frames, raising the render scale to %d%%.", CONFIGURATION_DISPLAY_RENDER_SCALE_RAISING_MEASUREMENTS_COUNT * CONFIGURATION_DISPLAY_RENDER_SCALE_MEASURED_FRAMES_COUNT, _renderScalePercentage);
+		}
+		
+		_measuredFramesCount = 0;
+		_lateFramesCount = 0;
+	}
+
+	/** Draw a frame snapshot to the screen, then destroy the textures that are not used anymore (this is called by the render thread).
+	* @param pointerFrameSnapshot The snapshot to draw.
+	*/
+	static void _drawFrameSnapshot(FrameSnapshot *pointerFrameSnapshot)
+	{
+		DrawingCommand *pointerDrawingCommand;
+		SDL_Texture *pointerTargetTexture = NULL, *pointerDrawingTargetTexture;
+		bool isTargetTextureSelected = false, isWorldTextureDrawn = false, isWorldScaled = (_pointerWorldTexture != NULL) && (_renderScalePercentage < 100);
+		size_t i;
+		
+		// Group the drawings using the same texture, the recording order is kept for the drawings that can't be grouped
+		std::stable_sort(pointerFrameSnapshot->drawingCommands.begin(), pointerFrameSnapshot->drawingCommands.end(), _isDrawingCommandDrawnBefore);
+		
+		for (i = 0; i < pointerFrameSnapshot->drawingCommands.size(); i++)
+		{
+			pointerDrawingCommand = &pointerFrameSnapshot->drawingCommands[i];
+			
+			// The game world is drawn to its own texture when its resolution is lowered (the interface layer comes last, so the world is drawn before the display)
+			pointerDrawingTargetTexture = pointerDrawingCommand->pointerTargetTexture;
+			if (isWorldScaled && (pointerDrawingTargetTexture == NULL) && (pointerDrawingCommand->layerId != LAYER_ID_INTERFACE)) pointerDrawingTargetTexture = _pointerWorldTexture;
+			
+			// Draw to the next texture (the display comes last)
+			if (!isTargetTextureSelected || (pointerDrawingTargetTexture != pointerTargetTexture))
+			{
+				pointerTargetTexture = pointerDrawingTargetTexture;
+				if (pointerTargetTexture == NULL) _selectDisplay(isWorldTextureDrawn);
+				else
+				{
+					_selectTargetTexture(pointerTargetTexture);
+					
+					// Shrink the world drawings to the texture top left part (the scale is reset when another target is selected)
+					if (pointerTargetTexture == _pointerWorldTexture)
+					{
+						SDL_RenderSetScale(_pointerRenderer, _renderScalePercentage / 100.f, _renderScalePercentage / 100.f);
+						isWorldTextureDrawn = true;
+					}
+				}
+				isTargetTextureSelected = true;
+			}
+			
+			switch (pointerDrawingCommand->type)
+			{
+				case DRAWING_COMMAND_TYPE_TEXTURE:
+					_drawTexture(pointerDrawingCommand, pointerTargetTexture == _pointerWorldTexture);
+					break;
+					
+				// The batched sprites must be drawn before anything else to keep the displaying order
+				case DRAWING_COMMAND_TYPE_RECTANGLE:
+					_flushSpriteBatch();
+					SDL_SetRenderDrawColor(_pointerRenderer, pointerDrawingCommand->color.r, pointerDrawingCommand->color.g, pointerDrawingCommand->color.b, 255);
+					SDL_RenderDrawRect(_pointerRenderer, &pointerDrawingCommand->destinationRectangle);
+					SDL_SetRenderDrawColor(_pointerRenderer, 0, 0, 0, 255);
+					break;
+					
+				case DRAWING_COMMAND_TYPE_TEXT:
+					_drawText(pointerDrawingCommand, pointerFrameSnapshot->texts.c_str() + pointerDrawingCommand->textOffset);
+					break;
+			}
+		}
+		
+		// Clean the display even if nothing was drawn to it
+		if (!isTargetTextureSelected || (pointerTargetTexture != NULL)) _selectDisplay(isWorldTextureDrawn);
+		
+		// Display the rendered picture
+		_flushSpriteBatch();
+		SDL_RenderPresent(_pointerRenderer);
+		if (_isRenderScaleAutomatic) _adjustRenderScale();
+		
+		// The next frames can't display these textures
+		for (i = 0; i < pointerFrameSnapshot->texturesToDestroy.size(); i++) SDL_DestroyTexture(pointerFrameSnapshot->texturesToDestroy[i]);
+		pointerFrameSnapshot->texturesToDestroy.clear();
+	}
+
+	/** Wait until the next frame can start according to the frame rate limit. The thread sleeps while the next frame time is far, then it actively waits for the remaining time because sleeping is not accurate enough. */
+	static void _waitForNextFrameTime()
+	{
+		Uint64 performanceCounterValue = SDL_GetPerformanceCounter();
+		
+		if (performanceCounterValue < _nextFrameStartingCounterValue)
+		{
+			// Sleep until the time is near
+			Uint64 remainingCounterTicks = _nextFrameStartingCounterValue - performanceCounterValue;
+			if (remainingCounterTicks > _frameLimiterSpinCounterTicks) SDL_Delay((Uint32) (((remainingCounterTicks - _frameLimiterSpinCounterTicks) * 1000) / SDL_GetPerformanceFrequency()));
+			
+			// Spin for the remaining time
+			while (SDL_GetPerformanceCounter() < _nextFrameStartingCounterValue);
+		}
+		// Do not try to catch up on the frames that were missed by more than a frame period (it would display a burst of frames), start counting again from now
+		else if (performanceCounterValue - _nextFrameStartingCounterValue > _framePeriodCounterTicks) _nextFrameStartingCounterValue = performanceCounterValue;
+		
+		// Keep a constant pace by computing the next frame time from this frame expected time rather than from the current time
+		_nextFrameStartingCounterValue += _framePeriodCounterTicks;
+	}
+
+	/** Draw the most recent frame snapshot each time the game records one, and serve the other threads requests.
+	* @return Always 0.
+	*/
+	static int _renderThread(void *)
+	{
+		RenderThreadRequestFunction pointerRequestFunction;
+		FrameSnapshot *pointerFrameSnapshot;
+		
+		SDL_LockMutex(_pointerMutex);
+		while (1)
+		{
+			// Wait for something to do
+			while ((_pointerRequestFunction == NULL) && !_isFrameSnapshotPending && !_isTerminationRequested)
+			{
+				_isFrameSnapshotWaited = true;
+				SDL_CondWait(_pointerRenderThreadCondition, _pointerMutex);
+			}
+			
+			// Serve the requests first because the requesting thread is waiting
+			if (_pointerRequestFunction != NULL)
+			{
+				pointerRequestFunction = _pointerRequestFunction;
+				SDL_UnlockMutex(_pointerMutex);
+				pointerRequestFunction(_pointerRequestParameter);
+				SDL_LockMutex(_pointerMutex);
+				
+				_pointerRequestFunction = NULL;
+				SDL_CondSignal(_pointerRequestFinishedCondition);
+			}
+			// Take the most recent frame snapshot (the game can record the next one meanwhile)
+			else if (_isFrameSnapshotPending)
+			{
+				pointerFrameSnapshot = _pointerPendingFrameSnapshot;
+				_pointerPendingFrameSnapshot = _pointerDrawnFrameSnapshot;
+				_pointerDrawnFrameSnapshot = pointerFrameSnapshot;
+				_isFrameSnapshotPending = false;
+				SDL_CondSignal(_pointerFrameSnapshotTakenCondition);
+				
+				SDL_UnlockMutex(_pointerMutex);
+				_drawFrameSnapshot(pointerFrameSnapshot);
+				_isFrameSnapshotWaited = false;
+				SDL_LockMutex(_pointerMutex);
+			}
+			// Exit only when everything has been served
+			else break;
+		}
+		SDL_UnlockMutex(_pointerMutex);
+		
+		_destroyRenderer();
+		return 0;
+	}
+
+	/** Make the render thread run a function and wait for it to finish. The function is directly called when there is no render thread.
+	* @param pointerFunction The function to run.
+	* @param pointerParameter The parameter to give to the function.
+	*/
+	static void _runOnRenderThread(RenderThreadRequestFunction pointerFunction, void *pointerParameter)
+	{
+		if (!_isRenderThreadEnabled)
+		{
+			pointerFunction(pointerParameter);
+			return;
+		}
+		
+		SDL_LockMutex(_pointerMutex);
+		_pointerRequestFunction = pointerFunction;
+		_pointerRequestParameter = pointerParameter;
+		SDL_CondSignal(_pointerRenderThreadCondition);
+		while (_pointerRequestFunction != NULL) SDL_CondWait(_pointerRequestFinishedCondition, _pointerMutex);
+		SDL_UnlockMutex(_pointerMutex);
+	}
+
+	/** Start the render thread if the platform allows it.
+	* @return 0 if the thread was started,
+	* @return -1 if an error occurred.
+	*/
+	static int _startRenderThread()
+	{
+		if (!_isRenderThreadEnabled) return 0;
+		
+		_pointerMutex = SDL_CreateMutex();
+		_pointerRenderThreadCondition = SDL_CreateCond();
+		_pointerRequestFinishedCondition = SDL_CreateCond();
+		_pointerFrameSnapshotTakenCondition = SDL_CreateCond();
+		if ((_pointerMutex == NULL) || (_pointerRenderThreadCondition == NULL) || (_pointerRequestFinishedCondition == NULL) || (_pointerFrameSnapshotTakenCondition == NULL))
+		{
+			LOG_ERROR("Failed to create the render thread synchronization objects (%s).", SDL_GetError());
+			return -1;
+		}
+		
+		_pointerRenderThread = SDL_CreateThread(_renderThread, "Render", NULL);
+		if (_pointerRenderThread == NULL)
+		{
+			LOG_ERROR("Failed to create the render thread (%s).", SDL_GetError());
+			return -1;
+		}
+		return 0;
+	}
+
+	/** Wait for the render thread to draw the last recorded frame, then stop it and destroy the renderer. */
+	static void _stopRenderThread()
+	{
+		// The render thread destroys the renderer when it exits
+		if (_pointerRenderThread != NULL)
+		{
+			SDL_LockMutex(_pointerMutex);
+			_isTerminationRequested = true;
+			SDL_CondSignal(_pointerRenderThreadCondition);
+			SDL_UnlockMutex(_pointerMutex);
+			
+			SDL_WaitThread(_pointerRenderThread, NULL);
+			_pointerRenderThread = NULL;
+		}
+		else _destroyRenderer();
+		
+		SDL_DestroyCond(_pointerFrameSnapshotTakenCondition);
+		SDL_DestroyCond(_pointerRequestFinishedCondition);
+		SDL_DestroyCond(_pointerRenderThreadCondition);
+		SDL_DestroyMutex(_pointerMutex);
+	}
+
+	int initialize(bool isFullScreenEnabled, bool isHeadlessModeRequested, VSyncMode vsyncMode, int framesPerSecondLimit, int renderScalePercentage)
+	{
+		unsigned int flags;
+		int result, framesPerSecond;
+		SDL_DisplayMode displayMode;
+		
+		// Nothing to create when the game is only simulated, but the display size is still needed by the game logic
+		if (isHeadlessModeRequested)
+		{
+			isHeadlessModeEnabled = true;
+			displayWidth = CONFIGURATION_DISPLAY_WIDTH;
+			displayHeight = CONFIGURATION_DISPLAY_HEIGHT;
+			LOG_INFORMATION("Headless mode enabled, nothing will be displayed.");
+			return 0;
+		}
 
 		// Tell Windows that high DPI is supported by the application, so "DPI Unaware" mode is not enabled (it would decrease the reported screen resolution is some scaling factor is enabled in Windows)
 		#ifdef _WIN32
@@ -66,37 +966,24 @@ namespace Renderer
 			goto Exit_Error;
 		}
 		
-		// Create the window renderer
-		pointerRenderer = SDL_CreateRenderer(_pointerMainWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-		if (pointerRenderer == NULL)
-		{
-			LOG_ERROR("Failed to create the main renderer (%s).", SDL_GetError());
-			goto Exit_Error_Destroy_Window;
-		}
+		// Configure frames pacing (the frame period is computed with the performance counter resolution, a millisecond resolution can't match most refresh rates)
+		_vsyncMode = vsyncMode;
+		if (framesPerSecondLimit > 0) _framePeriodCounterTicks = SDL_GetPerformanceFrequency() / framesPerSecondLimit;
+		_frameLimiterSpinCounterTicks = (SDL_GetPerformanceFrequency() * CONFIGURATION_DISPLAY_FRAME_LIMITER_SPIN_DURATION_MICROSECONDS) / 1000000;
+		LOG_DEBUG("VSync mode : %d, frames per second limit : %d.", vsyncMode, framesPerSecondLimit);
 		
-		// Display rendering driver name
-		if (SDL_GetRendererInfo(pointerRenderer, &rendererInformation) == 0) LOG_DEBUG("Rendering driver : %s.", rendererInformation.name);
+		// Start the thread that will own the renderer
+		if (_startRenderThread() != 0) goto Exit_Error_Stop_Render_Thread;
 		
-		// Set display size according to selected mode
-		if (isFullScreenEnabled)
-		{
-			if (SDL_GetRendererOutputSize(pointerRenderer, &displayWidth, &displayHeight) != 0)
-			{
-				LOG_ERROR("Failed to get renderer output size (%s).", SDL_GetError());
-				goto Exit_Error_Destroy_Window;
-			}
-		}
-		else
-		{
-			displayWidth = CONFIGURATION_DISPLAY_WIDTH;
-			displayHeight = CONFIGURATION_DISPLAY_HEIGHT;
-		}
+		// Create the window renderer from the render thread, because some rendering drivers can only be used by the thread that created them
+		_runOnRenderThread(_createRenderer, &isFullScreenEnabled);
+		if (_pointerRenderer == NULL) goto Exit_Error_Stop_Render_Thread;
 		
 		// Initialize SDL TTF
 		if (TTF_Init() != 0)
 		{
 			LOG_ERROR("Failed to initialize SDL TTF library (%s).", TTF_GetError());
-			goto Exit_Error_Destroy_Renderer;
+			goto Exit_Error_Stop_Render_Thread;
 		}
 		
 		// Try to load the fonts
@@ -165,16 +1052,36 @@ namespace Renderer
 		_textColors[TEXT_COLOR_DARK_GREY].b = 47;
 		_textColors[TEXT_COLOR_DARK_GREY].a = 255;
 		
+		// Render all characters once, so the texts do not need to be rendered when they change
+		_runOnRenderThread(_createGlyphAtlas, &result);
+		if (result != 0) goto Exit_Error_Uninitialize_TTF;
+		
+		// Draw the game world at a lower resolution if requested, a missing world texture is not fatal
+		if (renderScalePercentage != 100)
+		{
+			_runOnRenderThread(_createWorldTexture, &result);
+			if (result != 0) LOG_INFORMATION("The game world will be drawn at the display resolution.");
+			else if (renderScalePercentage > 0) _renderScalePercentage = renderScalePercentage;
+			else
+			{
+				// A frame presented one and a half frame period after the previous one missed a refresh
+				if (framesPerSecondLimit > 0) framesPerSecond = framesPerSecondLimit;
+				else if ((SDL_GetWindowDisplayMode(_pointerMainWindow, &displayMode) == 0) && (displayMode.refresh_rate > 0)) framesPerSecond = displayMode.refresh_rate;
+				else framesPerSecond = CONFIGURATION_DISPLAY_DEFAULT_REFRESH_RATE;
+				_lateFrameCounterTicks = (SDL_GetPerformanceFrequency() * 3) / (framesPerSecond * 2);
+				_isRenderScaleAutomatic = true;
+			}
+			LOG_DEBUG("Render scale : %d%%, automatic render scale : %d.", _renderScalePercentage, _isRenderScaleAutomatic);
+		}
+		
 		// Everything went fine
 		return 0;
 		
 	Exit_Error_Uninitialize_TTF:
 		TTF_Quit();
 		
-	Exit_Error_Destroy_Renderer:
-		SDL_DestroyRenderer(pointerRenderer);
-
-	Exit_Error_Destroy_Window:
+	Exit_Error_Stop_Render_Thread:
+		_stopRenderThread();
 		SDL_DestroyWindow(_pointerMainWindow);
 		
 	Exit_Error:
@@ -183,31 +1090,118 @@ namespace Renderer
 
 	void uninitialize()
 	{
-		for (int i = 0; i < FONT_SIZE_IDS_COUNT; i++) TTF_CloseFont(_pointerFonts[i]);
-		TTF_Quit();
-		
-		SDL_DestroyRenderer(pointerRenderer);
-		SDL_DestroyWindow(_pointerMainWindow);
+		// Headless mode did not create anything
+		if (!isHeadlessModeEnabled)
+		{
+			for (int i = 0; i < FONT_SIZE_IDS_COUNT; i++) TTF_CloseFont(_pointerFonts[i]);
+			TTF_Quit();
+			
+			_stopRenderThread();
+			SDL_DestroyWindow(_pointerMainWindow);
+		}
 		SDL_Quit();
 	}
 
 	void beginFrame()
 	{
-		// Store the time when the frame computation started
-		_frameStartingTime = SDL_GetTicks();
+		if (isHeadlessModeEnabled) return;
 		
-		// Clean the rendering area
-		SDL_RenderClear(pointerRenderer);
+		// Do not record frames faster than the render thread can draw them, a frame replacing a pending one would be computed for nothing (when VSync is enabled, this makes the game wait for the display refresh)
+		if (_isRenderThreadEnabled)
+		{
+			SDL_LockMutex(_pointerMutex);
+			while (_isFrameSnapshotPending) SDL_CondWait(_pointerFrameSnapshotTakenCondition, _pointerMutex);
+			SDL_UnlockMutex(_pointerMutex);
+		}
+		
+		// Wait for the frame rate limit
+		if (_framePeriodCounterTicks > 0) _waitForNextFrameTime();
+		
+		// Start recording a new frame (keep the textures to destroy, they belong to the frames that were not drawn yet)
+		_pointerRecordedFrameSnapshot->drawingCommands.clear();
+		_pointerRecordedFrameSnapshot->texts.clear();
+		_currentLayerId = LAYER_ID_SCENE;
+		_pointerCurrentTargetTexture = NULL;
+	}
+
+	void setLayer(LayerId layerId)
+	{
+		assert(layerId < LAYER_IDS_COUNT);
+		_currentLayerId = layerId;
 	}
 
 	void endFrame()
 	{
-		// Display the rendered picture
-		SDL_RenderPresent(pointerRenderer);
+		if (isHeadlessModeEnabled) return;
+		
+		// Draw the frame immediately when there is no render thread
+		if (!_isRenderThreadEnabled) _drawFrameSnapshot(_pointerRecordedFrameSnapshot);
+		else
+		{
+			// Give the recorded frame to the render thread
+			SDL_LockMutex(_pointerMutex);
+			FrameSnapshot *pointerFrameSnapshot = _pointerPendingFrameSnapshot;
+			_pointerPendingFrameSnapshot = _pointerRecordedFrameSnapshot;
+			_pointerRecordedFrameSnapshot = pointerFrameSnapshot;
+			
+			// The previous frame will never be drawn if the render thread did not take it yet, so its textures must be destroyed with the new frame
+			if (_isFrameSnapshotPending)
+			{
+				_pointerPendingFrameSnapshot->texturesToDestroy.insert(_pointerPendingFrameSnapshot->texturesToDestroy.end(), _pointerRecordedFrameSnapshot->texturesToDestroy.begin(), _pointerRecordedFrameSnapshot->texturesToDestroy.end());
+				_pointerRecordedFrameSnapshot->texturesToDestroy.clear();
+			}
+			_isFrameSnapshotPending = true;
+			SDL_CondSignal(_pointerRenderThreadCondition);
+			SDL_UnlockMutex(_pointerMutex);
+		}
+	}
 
-		// Wait enough time to achieve a 60Hz refresh rate
-		unsigned int frameElapsedTime = SDL_GetTicks() - _frameStartingTime;
-		if (frameElapsedTime < CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS) SDL_Delay(CONFIGURATION_DISPLAY_REFRESH_PERIOD_MILLISECONDS - frameElapsedTime);
+	SDL_Texture *createTextureFromSurface(SDL_Surface *pointerSurface)
+	{
+		// There is no renderer to create the texture for
+		if (isHeadlessModeEnabled) return NULL;
+		
+		TextureCreationRequest request;
+		request.pointerSurface = pointerSurface;
+		_runOnRenderThread(_createTextureFromSurface, &request);
+		
+		return request.pointerTexture;
+	}
+
+	SDL_Texture *createTargetTexture(int width, int height)
+	{
+		// There is no renderer to create the texture for
+		if (isHeadlessModeEnabled) return NULL;
+		
+		TargetTextureCreationRequest request;
+		request.width = width;
+		request.height = height;
+		_runOnRenderThread(_createTargetTexture, &request);
+		
+		return request.pointerTexture;
+	}
+
+	void beginTextureDrawing(SDL_Texture *pointerTargetTexture)
+	{
+		assert(pointerTargetTexture != NULL);
+		assert(_pointerCurrentTargetTexture == NULL);
+		_pointerCurrentTargetTexture = pointerTargetTexture;
+	}
+
+	void endTextureDrawing()
+	{
+		assert(_pointerCurrentTargetTexture != NULL);
+		_pointerCurrentTargetTexture = NULL;
+	}
+
+	void destroyTexture(SDL_Texture *pointerTexture)
+	{
+		if (pointerTexture == NULL) return;
+		
+		// Nothing can display the texture when the game is only simulated
+		if (isHeadlessModeEnabled) SDL_DestroyTexture(pointerTexture);
+		// Wait for the frames that may display the texture to be drawn
+		else _pointerRecordedFrameSnapshot->texturesToDestroy.push_back(pointerTexture);
 	}
 
 	SDL_Texture *renderTextToTexture(const char *pointerStringText, TextColorId colorId, FontSizeId fontSizeId)
@@ -216,28 +1210,52 @@ namespace Renderer
 		assert(colorId < TEXT_COLOR_IDS_COUNT);
 		assert(fontSizeId < FONT_SIZE_IDS_COUNT);
 		
-		// Render the text
-		SDL_Surface *pointerSurface = TTF_RenderText_Blended(_pointerFonts[fontSizeId], pointerStringText, _textColors[colorId]);
-		if (pointerSurface == NULL)
+		// There is no font to render with
+		if (isHeadlessModeEnabled) return NULL;
+		
+		// Only the render thread can create textures
+		TextRenderingRequest request;
+		request.pointerStringText = pointerStringText;
+		request.colorId = colorId;
+		request.fontSizeId = fontSizeId;
+		_runOnRenderThread(_renderTextToTextureRequest, &request);
+		if (request.pointerTexture == NULL)
 		{
-			LOG_ERROR("Failed to render the text to a surface, shutting down (%s).", TTF_GetError());
+			LOG_ERROR("Failed to render the text to a texture, shutting down.");
 			exit(-1);
 		}
 		
-		// Convert it to a texture to be able to display it
-		SDL_Texture *pointerTexture = SDL_CreateTextureFromSurface(pointerRenderer, pointerSurface);
-		SDL_FreeSurface(pointerSurface);
-		if (pointerTexture == NULL)
+		return request.pointerTexture;
+	}
+
+	void renderTextureArea(SDL_Texture *pointerTexture, const SDL_Rect *pointerSourceRectangle, const SDL_Rect *pointerDestinationRectangle)
+	{
+		if (isHeadlessModeEnabled) return;
+		
+		DrawingCommand drawingCommand;
+		drawingCommand.type = DRAWING_COMMAND_TYPE_TEXTURE;
+		drawingCommand.layerId = _currentLayerId;
+		drawingCommand.pointerTargetTexture = _pointerCurrentTargetTexture;
+		drawingCommand.pointerTexture = pointerTexture;
+		if (pointerSourceRectangle != NULL)
 		{
-			LOG_ERROR("Failed to convert the surface to a texture, shutting down (%s).", SDL_GetError());
-			exit(-1);
+			drawingCommand.sourceRectangle = *pointerSourceRectangle;
+			drawingCommand.isSourceRectangleUsed = true;
 		}
-		
-		return pointerTexture;
+		else drawingCommand.isSourceRectangleUsed = false;
+		if (pointerDestinationRectangle != NULL)
+		{
+			drawingCommand.destinationRectangle = *pointerDestinationRectangle;
+			drawingCommand.isDestinationRectangleUsed = true;
+		}
+		else drawingCommand.isDestinationRectangleUsed = false;
+		_pointerRecordedFrameSnapshot->drawingCommands.push_back(drawingCommand);
 	}
 
 	void renderTexture(SDL_Texture *pointerTexture, int x, int y)
 	{
+		if (isHeadlessModeEnabled) return;
+		
 		// Get the texture dimensions
 		SDL_Rect destinationRectangle;
 		if (SDL_QueryTexture(pointerTexture, NULL, NULL, &destinationRectangle.w, &destinationRectangle.h) != 0)
@@ -249,11 +1267,13 @@ namespace Renderer
 		// Display the texture at the specified coordinates
 		destinationRectangle.x = x;
 		destinationRectangle.y = y;
-		SDL_RenderCopy(pointerRenderer, pointerTexture, NULL, &destinationRectangle);
+		renderTextureArea(pointerTexture, NULL, &destinationRectangle);
 	}
 
 	void renderCenteredTexture(SDL_Texture *pointerTexture, int y)
 	{
+		if (isHeadlessModeEnabled) return;
+		
 		// Get the texture dimensions
 		SDL_Rect destinationRectangle;
 		if (SDL_QueryTexture(pointerTexture, NULL, NULL, &destinationRectangle.w, &destinationRectangle.h) != 0)
@@ -268,6 +1288,45 @@ namespace Renderer
 		else destinationRectangle.y = y;
 		
 		// Display the centered texture
-		SDL_RenderCopy(pointerRenderer, pointerTexture, NULL, &destinationRectangle);
+		renderTextureArea(pointerTexture, NULL, &destinationRectangle);
+	}
+
+	void renderRectangle(const SDL_Rect *pointerRectangle, Uint8 red, Uint8 green, Uint8 blue)
+	{
+		if (isHeadlessModeEnabled) return;
+		
+		DrawingCommand drawingCommand;
+		drawingCommand.type = DRAWING_COMMAND_TYPE_RECTANGLE;
+		drawingCommand.layerId = _currentLayerId;
+		drawingCommand.pointerTargetTexture = _pointerCurrentTargetTexture;
+		drawingCommand.destinationRectangle = *pointerRectangle;
+		drawingCommand.color.r = red;
+		drawingCommand.color.g = green;
+		drawingCommand.color.b = blue;
+		_pointerRecordedFrameSnapshot->drawingCommands.push_back(drawingCommand);
+	}
+
+	void renderText(const char *pointerStringText, TextColorId colorId, FontSizeId fontSizeId, int x, int y)
+	{
+		// Make sure parameters are valid
+		assert(colorId < TEXT_COLOR_IDS_COUNT);
+		assert(fontSizeId < FONT_SIZE_IDS_COUNT);
+		
+		// Nothing to display (an empty string can't be rendered anyway)
+		if (isHeadlessModeEnabled || (pointerStringText[0] == 0)) return;
+		
+		// Keep a copy of the string, the caller may reuse its buffer before the frame is drawn
+		DrawingCommand drawingCommand;
+		drawingCommand.type = DRAWING_COMMAND_TYPE_TEXT;
+		drawingCommand.layerId = _currentLayerId;
+		drawingCommand.pointerTargetTexture = _pointerCurrentTargetTexture;
+		drawingCommand.destinationRectangle.x = x;
+		drawingCommand.destinationRectangle.y = y;
+		drawingCommand.textColorId = colorId;
+		drawingCommand.fontSizeId = fontSizeId;
+		drawingCommand.textOffset = (int) _pointerRecordedFrameSnapshot->texts.size();
+		_pointerRecordedFrameSnapshot->texts.append(pointerStringText);
+		_pointerRecordedFrameSnapshot->texts.push_back(0);
+		_pointerRecordedFrameSnapshot->drawingCommands.push_back(drawingCommand);
 	}
 }
@@ -0,0 +1,316 @@
+/** @file ReplayManager.cpp
+ * See ReplayManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <ControlManager.hpp>
+#include <cstdio>
+#include <cstring>
+#include <Log.hpp>
+#include <ReplayManager.hpp>
+#include <SimulationClock.hpp>
+
+namespace ReplayManager
+{
+	/** Identify a record file. */
+	static const char _magicNumber[4] = {'S', 'R', 'P', 'L'};
+	/** Increment this value each time the file format changes. */
+	static const int _FILE_FORMAT_VERSION = 1;
+
+	/** Recorded keys, the key state is stored in the tick inputs byte bit of the same index. */
+	static const ControlManager::KeyId _recordedKeyIds[] =
+	{
+		ControlManager::KEY_ID_GO_UP,
+		ControlManager::KEY_ID_GO_DOWN,
+		ControlManager::KEY_ID_GO_LEFT,
+		ControlManager::KEY_ID_GO_RIGHT,
+		ControlManager::KEY_ID_PRIMARY_SHOOT,
+		ControlManager::KEY_ID_SECONDARY_SHOOT
+	};
+	/** How many keys are recorded. */
+	static const int _RECORDED_KEYS_COUNT = sizeof(_recordedKeyIds) / sizeof(_recordedKeyIds[0]);
+	/** The tick inputs byte bit telling that the last pressed direction key was on the vertical axis. */
+	static const int _INPUT_BIT_VERTICAL_AXIS = 1 << _RECORDED_KEYS_COUNT;
+	/** The tick inputs byte bit telling that the level was restarted before the tick. */
+	static const int _INPUT_BIT_LEVEL_RESTART = 1 << (_RECORDED_KEYS_COUNT + 1);
+
+	/** The opened record file. */
+	static FILE *_pointerFile = NULL;
+	/** Tell whether the file is written or read. */
+	static bool _isRecording = false;
+
+	/** Consecutive identical ticks are stored only once followed by their count, this is the inputs byte of the ticks being counted. */
+	static int _currentTicksInputs;
+	/** The simulation time step (in milliseconds) of the ticks being counted. */
+	static unsigned int _currentTicksTimeStep;
+	/** How many identical ticks are still to be written or read. */
+	static unsigned int _currentTicksCount;
+
+	/** The simulation time when the previous tick was recorded. */
+	static unsigned int _previousTickTime;
+	/** Set when the level restart must be stored with the next recorded tick. */
+	static bool _isLevelRestartPending;
+
+	/** The game state checksum read from the end of the replayed file. */
+	static unsigned int _recordedGameStateChecksum;
+
+	/** Write a 32-bit value in little endian order.
+	* @param value The value to write.
+	*/
+	static void _writeInteger(unsigned int value)
+	{
+		for (int i = 0; i < 4; i++) fputc((value >> (i * 8)) & 0xFF, _pointerFile);
+	}
+
+	/** Read a 32-bit value stored in little endian order.
+	* @param pointerValue On output, contain the read value.
+	* @return 0 if the value was read,
+	* @return -1 if the end of the file was reached.
+	*/
+	static int _readInteger(unsigned int *pointerValue)
+	{
+		int byte;
+		
+		*pointerValue = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			byte = fgetc(_pointerFile);
+			if (byte == EOF) return -1;
+			*pointerValue |= (unsigned int) byte << (i * 8);
+		}
+		return 0;
+	}
+
+	/** Write a value using as few bytes as possible (7 bits of the value are stored in each byte, the byte most significant bit tells whether more bytes follow).
+	* @param value The value to write.
+	*/
+	static void _writeVariableLengthInteger(unsigned int value)
+	{
+		while (value >= 0x80)
+		{
+			fputc((value & 0x7F) | 0x80, _pointerFile);
+			value >>= 7;
+		}
+		fputc(value, _pointerFile);
+	}
+
+	/** Read a value written by _writeVariableLengthInteger().
+	* @param pointerValue On output, contain the read value.
+	* @return 0 if the value was read,
+	* @return -1 if the end of the file was reached.
+	*/
+	static int _readVariableLengthInteger(unsigned int *pointerValue)
+	{
+		int byte, shift = 0;
+		
+		*pointerValue = 0;
+		do
+		{
+			byte = fgetc(_pointerFile);
+			if ((byte == EOF) || (shift > 28)) return -1;
+			*pointerValue |= (unsigned int) (byte & 0x7F) << shift;
+			shift += 7;
+		} while (byte & 0x80);
+		return 0;
+	}
+
+	/** Write the identical ticks counted so far. */
+	static void _writeCurrentTicks()
+	{
+		if (_currentTicksCount == 0) return;
+		
+		_writeVariableLengthInteger(_currentTicksCount);
+		fputc(_currentTicksInputs, _pointerFile);
+		_writeVariableLengthInteger(_currentTicksTimeStep);
+		_currentTicksCount = 0;
+	}
+
+	int startRecording(const char *pointerStringFileName, GameStartingState *pointerGameStartingState)
+	{
+		// Try to create the file
+		_pointerFile = fopen(pointerStringFileName, "wb");
+		if (_pointerFile == NULL)
+		{
+			LOG_ERROR("Failed to create the record file '%s'.", pointerStringFileName);
+			return -1;
+		}
+		
+		// Write the header
+		fwrite(_magicNumber, 1, sizeof(_magicNumber), _pointerFile);
+		fputc(_FILE_FORMAT_VERSION, _pointerFile);
+		_writeInteger(pointerGameStartingState->randomSeed);
+		_writeInteger(pointerGameStartingState->startingLevelNumber);
+		_writeInteger(pointerGameStartingState->playerMaximumLifePointsAmount);
+		_writeInteger(pointerGameStartingState->playerAmmunitionAmount);
+		
+		_isRecording = true;
+		_currentTicksCount = 0;
+		_previousTickTime = SimulationClock::getTime();
+		_isLevelRestartPending = false;
+		
+		LOG_INFORMATION("Recording game to '%s'.", pointerStringFileName);
+		return 0;
+	}
+
+	void recordLevelRestart()
+	{
+		_isLevelRestartPending = true;
+	}
+
+	void recordTick()
+	{
+		int i, inputs = 0;
+		
+		if (!_isRecording) return;
+		
+		// Gather the inputs
+		for (i = 0; i < _RECORDED_KEYS_COUNT; i++)
+		{
+			if (ControlManager::isKeyPressed(_recordedKeyIds[i])) inputs |= 1 << i;
+		}
+		if (ControlManager::isLastPressedDirectionKeyOnVerticalAxis()) inputs |= _INPUT_BIT_VERTICAL_AXIS;
+		if (_isLevelRestartPending)
+		{
+			inputs |= _INPUT_BIT_LEVEL_RESTART;
+			_isLevelRestartPending = false;
+		}
+		
+		// Get the simulation time elapsed during this tick
+		unsigned int currentTime = SimulationClock::getTime();
+		unsigned int timeStep = currentTime - _previousTickTime;
+		_previousTickTime = currentTime;
+		
+		// Count the tick if it is the same than the previous ones
+		if ((_currentTicksCount > 0) && (inputs == _currentTicksInputs) && (timeStep == _currentTicksTimeStep)) _currentTicksCount++;
+		else
+		{
+			_writeCurrentTicks();
+			_currentTicksInputs = inputs;
+			_currentTicksTimeStep = timeStep;
+			_currentTicksCount = 1;
+		}
+	}
+
+	void stopRecording(unsigned int gameStateChecksum)
+	{
+		if (!_isRecording) return;
+		
+		// Terminate the ticks list with a zero ticks count, then append the checksum
+		_writeCurrentTicks();
+		_writeVariableLengthInteger(0);
+		_writeInteger(gameStateChecksum);
+		
+		fclose(_pointerFile);
+		_pointerFile = NULL;
+		_isRecording = false;
+		LOG_INFORMATION("Recording stopped (game state checksum : 0x%08X).", gameStateChecksum);
+	}
+
+	int startReplay(const char *pointerStringFileName, GameStartingState *pointerGameStartingState)
+	{
+		char magicNumber[sizeof(_magicNumber)];
+		unsigned int values[4];
+		int i;
+		
+		// Try to open the file
+		_pointerFile = fopen(pointerStringFileName, "rb");
+		if (_pointerFile == NULL)
+		{
+			LOG_ERROR("Failed to open the record file '%s'.", pointerStringFileName);
+			return -1;
+		}
+		
+		// Make sure this is a supported record file
+		if ((fread(magicNumber, 1, sizeof(magicNumber), _pointerFile) != sizeof(magicNumber)) || (memcmp(magicNumber, _magicNumber, sizeof(magicNumber)) != 0) || (fgetc(_pointerFile) != _FILE_FORMAT_VERSION))
+		{
+			LOG_ERROR("The file '%s' is not a supported record file.", pointerStringFileName);
+			goto Exit_Error;
+		}
+		
+		// Read the header
+		for (i = 0; i < 4; i++)
+		{
+			if (_readInteger(&values[i]) != 0)
+			{
+				LOG_ERROR("The record file '%s' header is truncated.", pointerStringFileName);
+				goto Exit_Error;
+			}
+		}
+		pointerGameStartingState->randomSeed = values[0];
+		pointerGameStartingState->startingLevelNumber = values[1];
+		pointerGameStartingState->playerMaximumLifePointsAmount = values[2];
+		pointerGameStartingState->playerAmmunitionAmount = values[3];
+		
+		_currentTicksCount = 0;
+		_recordedGameStateChecksum = 0;
+		
+		LOG_INFORMATION("Replaying game from '%s'.", pointerStringFileName);
+		return 0;
+
+	Exit_Error:
+		fclose(_pointerFile);
+		_pointerFile = NULL;
+		return -1;
+	}
+
+	int replayTick(bool *pointerIsLevelRestarted)
+	{
+		int i;
+		
+		if (_pointerFile == NULL) return 1;
+		
+		// Read the next identical ticks when all previous ones have been replayed
+		if (_currentTicksCount == 0)
+		{
+			if (_readVariableLengthInteger(&_currentTicksCount) != 0) goto Exit_Error_Truncated_File;
+			
+			// Is the end of the record reached ?
+			if (_currentTicksCount == 0)
+			{
+				if (_readInteger(&_recordedGameStateChecksum) != 0) goto Exit_Error_Truncated_File;
+				return 1;
+			}
+			
+			_currentTicksInputs = fgetc(_pointerFile);
+			if (_currentTicksInputs == EOF) goto Exit_Error_Truncated_File;
+			if (_readVariableLengthInteger(&_currentTicksTimeStep) != 0) goto Exit_Error_Truncated_File;
+			
+			// The restart happens only before the first of these ticks
+			*pointerIsLevelRestarted = (_currentTicksInputs & _INPUT_BIT_LEVEL_RESTART) != 0;
+			_currentTicksInputs &= ~_INPUT_BIT_LEVEL_RESTART;
+		}
+		else *pointerIsLevelRestarted = false;
+		_currentTicksCount--;
+		
+		// Apply the inputs
+		for (i = 0; i < _RECORDED_KEYS_COUNT; i++) ControlManager::setKeyPressed(_recordedKeyIds[i], (_currentTicksInputs & (1 << i)) != 0);
+		ControlManager::setLastPressedDirectionKeyOnVerticalAxis((_currentTicksInputs & _INPUT_BIT_VERTICAL_AXIS) != 0);
+		
+		// Make the next clock update advance by the recorded amount of time
+		SimulationClock::setFixedTimeStep((int) _currentTicksTimeStep);
+		return 0;
+
+	Exit_Error_Truncated_File:
+		LOG_ERROR("The record file is truncated, stopping the replay.");
+		return 1;
+	}
+
+	unsigned int stopReplay()
+	{
+		if (_pointerFile != NULL)
+		{
+			fclose(_pointerFile);
+			_pointerFile = NULL;
+		}
+		return _recordedGameStateChecksum;
+	}
+
+	bool isRecording()
+	{
+		return _isRecording;
+	}
+
+	bool isReplaying()
+	{
+		return (_pointerFile != NULL) && !_isRecording;
+	}
+}
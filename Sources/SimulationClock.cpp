@@ -0,0 +1,146 @@
+/** @file SimulationClock.cpp
+ * See SimulationClock.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Configuration.hpp>
+#include <Log.hpp>
+#include <SDL2/SDL.h>
+#include <SimulationClock.hpp>
+
+namespace SimulationClock
+{
+	/** How many performance counter ticks are in one second. */
+	static Uint64 _performanceCounterFrequency;
+	/** The performance counter value when the simulation time was last advanced. */
+	static Uint64 _lastPerformanceCounterValue;
+	/** The real time elapsed since the last tick that has been told to be simulated, in microseconds. */
+	static Uint64 _accumulatedMicroseconds;
+
+	/** The simulation time in microseconds (keep a better resolution than milliseconds to avoid losing time on each update). */
+	static Uint64 _currentTimeMicroseconds;
+	/** How many ticks have been simulated. */
+	static unsigned int _ticksCount;
+
+	/** When set, the simulation time is advanced by a constant amount on each update. */
+	static bool _isFixedTimeStepEnabled;
+	/** How many microseconds to add on each update when the fixed time step is enabled. */
+	static Uint64 _fixedTimeStepMicroseconds;
+
+	/** Tell whether the simulation time is stopped. */
+	static bool _isPaused;
+	/** Multiply the real elapsed time by this value when computing the ticks to simulate. */
+	static double _scale;
+
+	int initialize()
+	{
+		_performanceCounterFrequency = SDL_GetPerformanceFrequency();
+		if (_performanceCounterFrequency == 0)
+		{
+			LOG_ERROR("The high resolution performance counter is not available.");
+			return -1;
+		}
+		
+		_lastPerformanceCounterValue = SDL_GetPerformanceCounter();
+		_accumulatedMicroseconds = 0;
+		_currentTimeMicroseconds = 0;
+		_ticksCount = 0;
+		_isFixedTimeStepEnabled = false;
+		_isPaused = false;
+		_scale = 1;
+		
+		LOG_DEBUG("Simulation clock initialized (performance counter frequency : %llu Hz).", (unsigned long long) _performanceCounterFrequency);
+		return 0;
+	}
+
+	/** Get the real time elapsed since the previous call.
+	* @return The elapsed time in microseconds.
+	*/
+	static Uint64 _measureElapsedMicroseconds()
+	{
+		// Convert the real elapsed time to microseconds (split the computation to avoid overflowing when the counter frequency is high)
+		Uint64 performanceCounterValue = SDL_GetPerformanceCounter();
+		Uint64 elapsedCounterTicks = performanceCounterValue - _lastPerformanceCounterValue;
+		_lastPerformanceCounterValue = performanceCounterValue;
+		
+		return ((elapsedCounterTicks / _performanceCounterFrequency) * 1000000) + (((elapsedCounterTicks % _performanceCounterFrequency) * 1000000) / _performanceCounterFrequency);
+	}
+
+	void update()
+	{
+		if (_isPaused) return;
+		
+		Uint64 elapsedMicroseconds;
+		if (_isFixedTimeStepEnabled) elapsedMicroseconds = _fixedTimeStepMicroseconds;
+		else elapsedMicroseconds = _measureElapsedMicroseconds();
+		
+		_currentTimeMicroseconds += elapsedMicroseconds;
+		_ticksCount++;
+	}
+
+	int getElapsedTicksCount()
+	{
+		if (_isPaused) return 0;
+		
+		// Scale the time here only, so the simulation time (advanced by one fixed step per tick) and the entities moves (a fixed amount of pixels per tick) always agree
+		_accumulatedMicroseconds += (Uint64) (_measureElapsedMicroseconds() * _scale);
+		int ticksCount = (int) (_accumulatedMicroseconds / (CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS * 1000));
+		_accumulatedMicroseconds %= CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS * 1000;
+		
+		// Forget about the time that can't be caught up
+		if (ticksCount > CONFIGURATION_GAMEPLAY_MAXIMUM_TICKS_PER_FRAME) ticksCount = CONFIGURATION_GAMEPLAY_MAXIMUM_TICKS_PER_FRAME;
+		return ticksCount;
+	}
+
+	float getInterpolationFactor()
+	{
+		return (float) _accumulatedMicroseconds / (CONFIGURATION_GAMEPLAY_TICK_PERIOD_MILLISECONDS * 1000);
+	}
+
+	void pause()
+	{
+		_isPaused = true;
+	}
+
+	void resume()
+	{
+		// Forget about the time elapsed while paused
+		_lastPerformanceCounterValue = SDL_GetPerformanceCounter();
+		_isPaused = false;
+	}
+
+	bool isPaused()
+	{
+		return _isPaused;
+	}
+
+	void setScale(float scale)
+	{
+		if (scale < 0) scale = 0;
+		_scale = scale;
+	}
+
+	void setFixedTimeStep(int milliseconds)
+	{
+		if (milliseconds < 0)
+		{
+			// Start measuring from now when going back to real time
+			if (_isFixedTimeStepEnabled) _lastPerformanceCounterValue = SDL_GetPerformanceCounter();
+			_isFixedTimeStepEnabled = false;
+		}
+		else
+		{
+			_isFixedTimeStepEnabled = true;
+			_fixedTimeStepMicroseconds = (Uint64) milliseconds * 1000;
+		}
+	}
+
+	unsigned int getTime()
+	{
+		return (unsigned int) (_currentTimeMicroseconds / 1000);
+	}
+
+	unsigned int getTicksCount()
+	{
+		return _ticksCount;
+	}
+}
@@ -2,22 +2,18 @@
  * See Texture.hpp for description.
  * @author Adrien RICCIARDI
  */
-#include <cstdlib>
-#include <Log.hpp>
 #include <Renderer.hpp>
 #include <Texture.hpp>
 
-Texture::Texture(SDL_Texture *pointerSDLTexture)
+Texture::Texture(SDL_Texture *pointerSDLTexture, int x, int y, int width, int height)
 {
-	// Cache width and height parameters
 	_pointerSDLTexture = pointerSDLTexture;
-	unsigned int pixelFormat;
-	int access;
-	if (SDL_QueryTexture(_pointerSDLTexture, &pixelFormat, &access, &_width, &_height) != 0)
-	{
-		LOG_ERROR("Failed to query texture information (%s).", SDL_GetError());
-		exit(-1);
-	}
+	_sourceRectangle.x = x;
+	_sourceRectangle.y = y;
+	_sourceRectangle.w = width;
+	_sourceRectangle.h = height;
+	_width = width;
+	_height = height;
 }
 
 int Texture::render(int x, int y)
@@ -29,7 +25,7 @@ int Texture::render(int x, int y)
 	positionRectangle.h = _height;
 	
 	// Render texture only if it is visible on the screen
-	if ((x + _width >= 0) && (y + _height >= 0) && (x < Renderer::displayWidth) && (y < Renderer::displayHeight)) SDL_RenderCopy(Renderer::pointerRenderer, _pointerSDLTexture, NULL, &positionRectangle);
+	if ((x + _width >= 0) && (y + _height >= 0) && (x < Renderer::displayWidth) && (y < Renderer::displayHeight)) Renderer::renderTextureArea(_pointerSDLTexture, &_sourceRectangle, &positionRectangle);
 	
 	return 0;
 }
@@ -2,11 +2,13 @@
  * See TextureManager.hpp for description.
  * @author Adrien RICCIARDI
  */
+#include <algorithm>
 #include <AnimatedTexture.hpp>
 #include <cassert>
 #include <Configuration.hpp>
 #include <cstdio>
 #include <FileManager.hpp>
+#include <JobManager.hpp>
 #include <Log.hpp>
 #include <Renderer.hpp>
 #include <SDL2/SDL.h>
@@ -17,6 +19,7 @@
 #endif
 #include <Texture.hpp>
 #include <TextureManager.hpp>
+#include <vector>
 
 namespace TextureManager
 {
@@ -26,7 +29,7 @@ namespace TextureManager
 		const char *pointerStringFileName; //!< The file the texture is loaded from.
 		int imagesCount; //!< How many images are contained in the provided file (in case of an animated texture). Set to 1 if the texture is not animated.
 		int framesPerImageCount; //!< Used only for animated textures. How many game frame to wait before displaying the next image.
-		SDL_Texture *pointerSDLTexture; //!< The SDL texture that can be rendered.
+		SDL_Texture *pointerSDLTexture; //!< The SDL texture that can be rendered (it is the atlas containing the image).
 		Texture *pointerTexture; //!< The game texture representation associated with this image (it can be still or animated).
 	} TextureInformation;
 
@@ -1176,47 +1179,206 @@ namespace TextureManager
 		}
 	};
 
-	int initialize()
+	/** Where each image is stored in the texture atlases. */
+	static SDL_Rect _atlasRectangles[TEXTURE_IDS_COUNT];
+	/** The atlas each image is stored in. */
+	static int _atlasIndexes[TEXTURE_IDS_COUNT];
+	/** The SDL textures of all atlases (there are none in headless mode). */
+	static std::vector<SDL_Texture *> _atlasesSDLTextures;
+
+	/** Pack all images into as few atlases as possible. Images are sorted from the tallest to the shortest and put side by side on shelves, so each shelf wastes little height.
+	* @param pointerSurfaces All decoded images.
+	* @param pointerAtlasesWidths On output, contain the width of each atlas.
+	* @param pointerAtlasesHeights On output, contain the height of each atlas.
+	* @return 0 if all images have been placed,
+	* @return -1 if an image is bigger than an atlas.
+	*/
+	static int _packImages(SDL_Surface *pointerSurfaces[], std::vector<int> *pointerAtlasesWidths, std::vector<int> *pointerAtlasesHeights)
 	{
-		// Load all files
-		SDL_Surface *pointerSurface;
-		for (int i = 0; i < TEXTURE_IDS_COUNT; i++)
+		int sortedIndexes[TEXTURE_IDS_COUNT], i, textureIndex, width, height, shelfX = 0, shelfY = 0, shelfHeight = 0, atlasIndex = 0;
+		
+		// Begin with the tallest images
+		for (i = 0; i < TEXTURE_IDS_COUNT; i++) sortedIndexes[i] = i;
+		std::sort(sortedIndexes, sortedIndexes + TEXTURE_IDS_COUNT, [pointerSurfaces](int firstIndex, int secondIndex)
 		{
-			// Try to load bitmap
-			pointerSurface = IMG_Load(_texturesInformations[i].pointerStringFileName);
-			if (pointerSurface == NULL)
+			if (pointerSurfaces[firstIndex]->h != pointerSurfaces[secondIndex]->h) return pointerSurfaces[firstIndex]->h > pointerSurfaces[secondIndex]->h;
+			return firstIndex < secondIndex; // Keep the same packing from one run to another
+		});
+		
+		pointerAtlasesWidths->assign(1, 0);
+		pointerAtlasesHeights->assign(1, 0);
+		for (i = 0; i < TEXTURE_IDS_COUNT; i++)
+		{
+			textureIndex = sortedIndexes[i];
+			width = pointerSurfaces[textureIndex]->w;
+			height = pointerSurfaces[textureIndex]->h;
+			if ((width > CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SIZE) || (height > CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SIZE))
 			{
-				LOG_ERROR("Failed to load texture '%s' (%s).", _texturesInformations[i].pointerStringFileName, SDL_GetError());
+				LOG_ERROR("The texture '%s' is bigger than a texture atlas (%dx%d pixels).", _texturesInformations[textureIndex].pointerStringFileName, width, height);
 				return -1;
 			}
 			
-			// Convert the surface to a texture
-			_texturesInformations[i].pointerSDLTexture = SDL_CreateTextureFromSurface(Renderer::pointerRenderer, pointerSurface);
-			SDL_FreeSurface(pointerSurface);
-			if (_texturesInformations[i].pointerSDLTexture == NULL)
+			// Start a new shelf when the image does not fit on the current one
+			if (shelfX + width > CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SIZE)
 			{
-				LOG_ERROR("Failed to convert the surface to a texture (%s).", SDL_GetError());
-				return -1;
+				shelfX = 0;
+				shelfY += shelfHeight + CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING;
+				shelfHeight = 0;
+			}
+			
+			// Start a new atlas when the shelf does not fit in the current one
+			if (shelfY + height > CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SIZE)
+			{
+				atlasIndex++;
+				pointerAtlasesWidths->push_back(0);
+				pointerAtlasesHeights->push_back(0);
+				shelfX = 0;
+				shelfY = 0;
+				shelfHeight = 0;
+			}
+			
+			// Put the image on the shelf
+			_atlasRectangles[textureIndex].x = shelfX;
+			_atlasRectangles[textureIndex].y = shelfY;
+			_atlasRectangles[textureIndex].w = width;
+			_atlasRectangles[textureIndex].h = height;
+			_atlasIndexes[textureIndex] = atlasIndex;
+			shelfX += width + CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING;
+			if (height > shelfHeight) shelfHeight = height;
+			
+			// Make the atlas only as big as needed
+			if (shelfX - CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING > (*pointerAtlasesWidths)[atlasIndex]) (*pointerAtlasesWidths)[atlasIndex] = shelfX - CONFIGURATION_DISPLAY_TEXTURE_ATLAS_SPACING;
+			if (shelfY + height > (*pointerAtlasesHeights)[atlasIndex]) (*pointerAtlasesHeights)[atlasIndex] = shelfY + height;
+		}
+		
+		return 0;
+	}
+
+	/** Copy the images into their atlas and convert the atlas to a texture.
+	* @param pointerSurfaces All decoded images.
+	* @param atlasIndex The atlas to create.
+	* @param width The atlas width in pixels.
+	* @param height The atlas height in pixels.
+	* @return The atlas texture on success,
+	* @return NULL if an error occurred.
+	*/
+	static SDL_Texture *_createAtlas(SDL_Surface *pointerSurfaces[], int atlasIndex, int width, int height)
+	{
+		SDL_Texture *pointerAtlasTexture = NULL;
+		SDL_Rect destinationRectangle;
+		int i;
+		
+		// A new surface is fully transparent
+		SDL_Surface *pointerAtlasSurface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+		if (pointerAtlasSurface == NULL)
+		{
+			LOG_ERROR("Failed to create the surface of the texture atlas %d (%s).", atlasIndex, SDL_GetError());
+			return NULL;
+		}
+		
+		for (i = 0; i < TEXTURE_IDS_COUNT; i++)
+		{
+			if (_atlasIndexes[i] != atlasIndex) continue;
+			
+			// Copy the image pixels as is, including their transparency
+			SDL_SetSurfaceBlendMode(pointerSurfaces[i], SDL_BLENDMODE_NONE);
+			destinationRectangle = _atlasRectangles[i]; // The blit function overwrites the rectangle
+			if (SDL_BlitSurface(pointerSurfaces[i], NULL, pointerAtlasSurface, &destinationRectangle) != 0)
+			{
+				LOG_ERROR("Failed to copy the texture '%s' to the texture atlas %d (%s).", _texturesInformations[i].pointerStringFileName, atlasIndex, SDL_GetError());
+				goto Exit;
+			}
+		}
+		
+		pointerAtlasTexture = Renderer::createTextureFromSurface(pointerAtlasSurface);
+		LOG_DEBUG("Created texture atlas %d. Width : %d, height : %d, SDL texture pointer : %p.", atlasIndex, width, height, pointerAtlasTexture);
+		
+	Exit:
+		SDL_FreeSurface(pointerAtlasSurface);
+		return pointerAtlasTexture;
+	}
+
+	/** Decode some image files (this is called by the worker threads).
+	* @param pointerSurfaces The array receiving the decoded surfaces, a surface is NULL if its file could not be loaded.
+	* @param firstItemIndex The first texture to load.
+	* @param itemsCount How many textures to load.
+	*/
+	static void _decodeFiles(void *pointerSurfaces, int firstItemIndex, int itemsCount)
+	{
+		SDL_Surface **pointerDecodedSurfaces = static_cast<SDL_Surface **>(pointerSurfaces);
+		for (int i = firstItemIndex; i < firstItemIndex + itemsCount; i++) pointerDecodedSurfaces[i] = IMG_Load(_texturesInformations[i].pointerStringFileName);
+	}
+
+	int initialize()
+	{
+		SDL_Surface *pointerSurfaces[TEXTURE_IDS_COUNT], *pointerSurface;
+		std::vector<int> atlasesWidths, atlasesHeights;
+		SDL_Texture *pointerAtlasTexture;
+		int i;
+		
+		// Decode all files simultaneously, the textures can only be created by the thread owning the renderer
+		JobManager::parallelFor(TEXTURE_IDS_COUNT, _decodeFiles, pointerSurfaces);
+		
+		// Make sure all files were loaded
+		for (i = 0; i < TEXTURE_IDS_COUNT; i++)
+		{
+			if (pointerSurfaces[i] == NULL)
+			{
+				LOG_ERROR("Failed to load texture '%s'.", _texturesInformations[i].pointerStringFileName);
+				goto Exit_Error;
 			}
+		}
+		
+		// Find a place for each image in the atlases
+		if (_packImages(pointerSurfaces, &atlasesWidths, &atlasesHeights) != 0) goto Exit_Error;
+		
+		// Convert the atlases to textures (only the images placement is needed in headless mode)
+		if (!Renderer::isHeadlessModeEnabled)
+		{
+			for (i = 0; i < (int) atlasesWidths.size(); i++)
+			{
+				pointerAtlasTexture = _createAtlas(pointerSurfaces, i, atlasesWidths[i], atlasesHeights[i]);
+				if (pointerAtlasTexture == NULL)
+				{
+					LOG_ERROR("Failed to create the texture atlas %d.", i);
+					goto Exit_Error;
+				}
+				_atlasesSDLTextures.push_back(pointerAtlasTexture);
+			}
+		}
+		
+		for (i = 0; i < TEXTURE_IDS_COUNT; i++)
+		{
+			pointerSurface = pointerSurfaces[i];
+			if (!Renderer::isHeadlessModeEnabled) _texturesInformations[i].pointerSDLTexture = _atlasesSDLTextures[_atlasIndexes[i]];
 			
 			// Create the associated game texture (TODO even for animated textures ?)
-			_texturesInformations[i].pointerTexture = new Texture(_texturesInformations[i].pointerSDLTexture);
+			_texturesInformations[i].pointerTexture = new Texture(_texturesInformations[i].pointerSDLTexture, _atlasRectangles[i].x, _atlasRectangles[i].y, pointerSurface->w, pointerSurface->h);
+			SDL_FreeSurface(pointerSurface);
+			pointerSurfaces[i] = NULL;
 			
-			LOG_DEBUG("Loaded texture. File name : %s, texture ID : %d, SDL texture pointer : %p.", _texturesInformations[i].pointerStringFileName, i, _texturesInformations[i].pointerSDLTexture);
+			LOG_DEBUG("Loaded texture. File name : %s, texture ID : %d, atlas : %d, x : %d, y : %d.", _texturesInformations[i].pointerStringFileName, i, _atlasIndexes[i], _atlasRectangles[i].x, _atlasRectangles[i].y);
 		}
-		LOG_DEBUG("Loaded %d textures.", TEXTURE_IDS_COUNT);
+		LOG_DEBUG("Loaded %d textures in %d texture atlases.", TEXTURE_IDS_COUNT, (int) atlasesWidths.size());
 		
 		return 0;
+		
+	Exit_Error:
+		// Free the surfaces that have not been converted yet
+		for (i = 0; i < TEXTURE_IDS_COUNT; i++) SDL_FreeSurface(pointerSurfaces[i]);
+		for (i = 0; i < (int) _atlasesSDLTextures.size(); i++) Renderer::destroyTexture(_atlasesSDLTextures[i]);
+		_atlasesSDLTextures.clear();
+		return -1;
 	}
 
 	void uninitialize()
 	{
+		int i;
+		
 		// Free all textures
-		for (int i = 0; i < TEXTURE_IDS_COUNT; i++)
-		{
-			delete _texturesInformations[i].pointerTexture;
-			SDL_DestroyTexture(_texturesInformations[i].pointerSDLTexture);
-		}
+		for (i = 0; i < TEXTURE_IDS_COUNT; i++) delete _texturesInformations[i].pointerTexture;
+		for (i = 0; i < (int) _atlasesSDLTextures.size(); i++) Renderer::destroyTexture(_atlasesSDLTextures[i]);
+		_atlasesSDLTextures.clear();
 	}
 
 	Texture *getTextureFromId(TextureId id)
@@ -1232,6 +1394,6 @@ namespace TextureManager
 		// Make sure the provided ID is valid
 		assert(id < TEXTURE_IDS_COUNT);
 		
-		return new AnimatedTexture(_texturesInformations[id].pointerSDLTexture, _texturesInformations[id].imagesCount, _texturesInformations[id].framesPerImageCount, isAnimationLooping);
+		return new AnimatedTexture(_texturesInformations[id].pointerTexture, _texturesInformations[id].imagesCount, _texturesInformations[id].framesPerImageCount, isAnimationLooping);
 	}
 }
@@ -0,0 +1,241 @@
+/** @file TimerManager.cpp
+ * See TimerManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Configuration.hpp>
+#include <Log.hpp>
+#include <SimulationClock.hpp>
+#include <TimerManager.hpp>
+#include <vector>
+
+namespace TimerManager
+{
+	/** How many slots the first wheel contains. */
+	#define FIRST_WHEEL_SLOTS_COUNT (1 << CONFIGURATION_TIMERS_FIRST_WHEEL_SLOTS_COUNT_BITS)
+	/** How many slots each following wheel contains. */
+	#define OTHER_WHEELS_SLOTS_COUNT (1 << CONFIGURATION_TIMERS_OTHER_WHEELS_SLOTS_COUNT_BITS)
+	/** How many slots all wheels contain. */
+	#define SLOTS_COUNT (FIRST_WHEEL_SLOTS_COUNT + ((CONFIGURATION_TIMERS_WHEELS_COUNT - 1) * OTHER_WHEELS_SLOTS_COUNT))
+
+	/** A scheduled timer, linked to the other timers of the same slot. */
+	typedef struct
+	{
+		unsigned int expirationTime; //!< The simulation time when the function must be called.
+		TimerFunction pointerFunction; //!< The function to call.
+		void *pointerParameter; //!< The parameter to give to the function.
+		int slotIndex; //!< The slot the timer is stored in.
+		int previousTimerIndex; //!< The previous timer of the slot, or -1 if the timer is the first one.
+		int nextTimerIndex; //!< The next timer of the slot (or the next free timer if the timer is not used), or -1 if the timer is the last one.
+	} Timer;
+
+	/** All timers, used or not. */
+	static std::vector<Timer> _timers;
+	/** The first unused timer, or -1 if all timers are used. */
+	static int _firstFreeTimerIndex;
+
+	/** The first timer of each slot, or -1 if the slot is empty. The first wheel slots come first, followed by the slots of each following wheel. */
+	static int _slotFirstTimerIndexes[SLOTS_COUNT];
+	/** The last timer of each slot, so timers are called in the order they were scheduled. */
+	static int _slotLastTimerIndexes[SLOTS_COUNT];
+
+	/** The last simulation time whose timers have been called. */
+	static unsigned int _currentTime;
+
+	/** Get the amount of bits to shift a time to the right to get a wheel slot.
+	* @param wheelIndex The wheel.
+	* @return The bits count.
+	*/
+	static inline int _getWheelShift(int wheelIndex)
+	{
+		if (wheelIndex == 0) return 0;
+		return CONFIGURATION_TIMERS_FIRST_WHEEL_SLOTS_COUNT_BITS + ((wheelIndex - 1) * CONFIGURATION_TIMERS_OTHER_WHEELS_SLOTS_COUNT_BITS);
+	}
+
+	/** Get the first slot of a wheel.
+	* @param wheelIndex The wheel.
+	* @return The index of the wheel first slot.
+	*/
+	static inline int _getWheelFirstSlotIndex(int wheelIndex)
+	{
+		if (wheelIndex == 0) return 0;
+		return FIRST_WHEEL_SLOTS_COUNT + ((wheelIndex - 1) * OTHER_WHEELS_SLOTS_COUNT);
+	}
+
+	/** Append a timer to the slot matching its expiration time.
+	* @param timerIndex The timer to store.
+	* @param referenceTime The next simulation time whose timers will be called. Timers expiring before this time are stored as if they expired at this time.
+	*/
+	static void _insertTimer(int timerIndex, unsigned int referenceTime)
+	{
+		Timer *pointerTimer = &_timers[timerIndex];
+		unsigned int expirationTime = pointerTimer->expirationTime;
+		int wheelIndex, wheelShift = 0, wheelSlotsCount = FIRST_WHEEL_SLOTS_COUNT, slotIndex;
+		
+		// Use unsigned subtraction to handle the time wrapping, like with SDL_GetTicks()
+		if ((int) (expirationTime - referenceTime) < 0) expirationTime = referenceTime;
+		unsigned int remainingTime = expirationTime - referenceTime;
+		
+		// Find the first wheel able to count the remaining time
+		for (wheelIndex = 0; wheelIndex < CONFIGURATION_TIMERS_WHEELS_COUNT; wheelIndex++)
+		{
+			wheelShift = _getWheelShift(wheelIndex);
+			if (wheelIndex > 0) wheelSlotsCount = OTHER_WHEELS_SLOTS_COUNT;
+			
+			if ((unsigned long long) remainingTime < ((unsigned long long) wheelSlotsCount << wheelShift)) break;
+		}
+		
+		// The timer expires later than the wheels can count, put it in the farthest slot of the last wheel, it will be moved again when this slot is reached
+		if (wheelIndex == CONFIGURATION_TIMERS_WHEELS_COUNT)
+		{
+			wheelIndex--;
+			expirationTime = referenceTime + (unsigned int) (((unsigned long long) wheelSlotsCount << wheelShift) - 1);
+		}
+		slotIndex = _getWheelFirstSlotIndex(wheelIndex) + ((expirationTime >> wheelShift) & (wheelSlotsCount - 1));
+		
+		// Append the timer to the slot
+		pointerTimer->slotIndex = slotIndex;
+		pointerTimer->previousTimerIndex = _slotLastTimerIndexes[slotIndex];
+		pointerTimer->nextTimerIndex = -1;
+		if (_slotLastTimerIndexes[slotIndex] == -1) _slotFirstTimerIndexes[slotIndex] = timerIndex;
+		else _timers[_slotLastTimerIndexes[slotIndex]].nextTimerIndex = timerIndex;
+		_slotLastTimerIndexes[slotIndex] = timerIndex;
+	}
+
+	/** Remove a timer from its slot.
+	* @param timerIndex The timer to remove.
+	*/
+	static void _removeTimer(int timerIndex)
+	{
+		Timer *pointerTimer = &_timers[timerIndex];
+		
+		if (pointerTimer->previousTimerIndex == -1) _slotFirstTimerIndexes[pointerTimer->slotIndex] = pointerTimer->nextTimerIndex;
+		else _timers[pointerTimer->previousTimerIndex].nextTimerIndex = pointerTimer->nextTimerIndex;
+		if (pointerTimer->nextTimerIndex == -1) _slotLastTimerIndexes[pointerTimer->slotIndex] = pointerTimer->previousTimerIndex;
+		else _timers[pointerTimer->nextTimerIndex].previousTimerIndex = pointerTimer->previousTimerIndex;
+	}
+
+	/** Give a removed timer back to the free timers.
+	* @param timerIndex The timer to free.
+	*/
+	static inline void _freeTimer(int timerIndex)
+	{
+		_timers[timerIndex].pointerFunction = NULL;
+		_timers[timerIndex].nextTimerIndex = _firstFreeTimerIndex;
+		_firstFreeTimerIndex = timerIndex;
+	}
+
+	/** Move all timers of a slot to the lower wheels, now that their expiration time is near enough.
+	* @param slotIndex The slot to empty.
+	*/
+	static void _cascadeSlot(int slotIndex)
+	{
+		int timerIndex = _slotFirstTimerIndexes[slotIndex], nextTimerIndex;
+		
+		// Empty the slot before storing the timers again, in case some of them must come back to this slot
+		_slotFirstTimerIndexes[slotIndex] = -1;
+		_slotLastTimerIndexes[slotIndex] = -1;
+		
+		while (timerIndex != -1)
+		{
+			nextTimerIndex = _timers[timerIndex].nextTimerIndex;
+			_insertTimer(timerIndex, _currentTime);
+			timerIndex = nextTimerIndex;
+		}
+	}
+
+	int initialize()
+	{
+		for (int i = 0; i < SLOTS_COUNT; i++)
+		{
+			_slotFirstTimerIndexes[i] = -1;
+			_slotLastTimerIndexes[i] = -1;
+		}
+		_timers.clear();
+		_firstFreeTimerIndex = -1;
+		_currentTime = SimulationClock::getTime();
+		
+		return 0;
+	}
+
+	void uninitialize()
+	{
+		std::vector<Timer>().swap(_timers);
+		_firstFreeTimerIndex = -1;
+	}
+
+	void update()
+	{
+		unsigned int time = SimulationClock::getTime();
+		int wheelIndex, wheelShift, slotIndex, timerIndex;
+		Timer *pointerTimer;
+		
+		// Visit each millisecond elapsed since the previous update, there are only a few of them per tick
+		while (_currentTime != time)
+		{
+			_currentTime++;
+			
+			// Move the timers of the next slot of a wheel to the lower wheels each time the previous wheel has done a whole turn
+			for (wheelIndex = 1; wheelIndex < CONFIGURATION_TIMERS_WHEELS_COUNT; wheelIndex++)
+			{
+				wheelShift = _getWheelShift(wheelIndex);
+				if ((_currentTime & ((1u << wheelShift) - 1)) != 0) break;
+				
+				_cascadeSlot(_getWheelFirstSlotIndex(wheelIndex) + ((_currentTime >> wheelShift) & (OTHER_WHEELS_SLOTS_COUNT - 1)));
+			}
+			
+			// Call the expired timers (a called function can schedule or cancel timers, so the slot is read again after each call)
+			slotIndex = _currentTime & (FIRST_WHEEL_SLOTS_COUNT - 1);
+			while (_slotFirstTimerIndexes[slotIndex] != -1)
+			{
+				timerIndex = _slotFirstTimerIndexes[slotIndex];
+				_removeTimer(timerIndex);
+				
+				pointerTimer = &_timers[timerIndex];
+				TimerFunction pointerFunction = pointerTimer->pointerFunction;
+				void *pointerParameter = pointerTimer->pointerParameter;
+				_freeTimer(timerIndex);
+				
+				pointerFunction(pointerParameter);
+			}
+		}
+	}
+
+	int schedule(unsigned int delayMilliseconds, TimerFunction pointerFunction, void *pointerParameter)
+	{
+		int timerIndex;
+		
+		// Recycle a free timer if possible
+		if (_firstFreeTimerIndex != -1)
+		{
+			timerIndex = _firstFreeTimerIndex;
+			_firstFreeTimerIndex = _timers[timerIndex].nextTimerIndex;
+		}
+		else
+		{
+			timerIndex = _timers.size();
+			_timers.resize(timerIndex + 1);
+		}
+		
+		Timer *pointerTimer = &_timers[timerIndex];
+		pointerTimer->expirationTime = SimulationClock::getTime() + delayMilliseconds;
+		pointerTimer->pointerFunction = pointerFunction;
+		pointerTimer->pointerParameter = pointerParameter;
+		_insertTimer(timerIndex, _currentTime + 1); // The timers of the current time have already been called
+		
+		return timerIndex;
+	}
+
+	void cancel(int timerId)
+	{
+		if (timerId == TIMER_ID_NONE) return;
+		
+		if (_timers[timerId].pointerFunction == NULL)
+		{
+			LOG_ERROR("Cancelling the timer %d which is not scheduled.", timerId);
+			return;
+		}
+		
+		_removeTimer(timerId);
+		_freeTimer(timerId);
+	}
+}
@@ -0,0 +1,179 @@
+/** @file VisibilityManager.cpp
+ * See VisibilityManager.hpp for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Configuration.hpp>
+#include <Entity.hpp>
+#include <Renderer.hpp>
+#include <vector>
+#include <VisibilityManager.hpp>
+
+namespace VisibilityManager
+{
+	/** A cell width and height in pixels. */
+	#define CELL_SIZE_PIXELS (CONFIGURATION_VISIBILITY_CELL_SIZE * CONFIGURATION_LEVEL_BLOCK_SIZE)
+
+	/** An entity stored in a cell, linked to the other entities of the same kind and cell. */
+	typedef struct
+	{
+		Entity *pointerEntity; //!< The entity, NULL if the node is not used.
+		EntityType entityType; //!< The entity kind.
+		int cellIndex; //!< The cell the entity is stored in.
+		int previousNodeIndex; //!< The previous entity of the cell, or -1 if the entity is the first one.
+		int nextNodeIndex; //!< The next entity of the cell (or the next free node if the node is not used), or -1 if the entity is the last one.
+	} Node;
+
+	/** All nodes, used or not. */
+	static std::vector<Node> _nodes;
+	/** The first unused node, or -1 if all nodes are used. */
+	static int _firstFreeNodeIndex = -1;
+
+	/** The level width in cells. */
+	static int _levelWidthCells = 0;
+	/** The level height in cells. */
+	static int _levelHeightCells = 0;
+	/** The first entity of each cell, or -1 if the cell is empty. All cells of the first entity kind come first, followed by the cells of each following kind. */
+	static std::vector<int> _cellFirstNodeIndexes;
+
+	/** Get the cell containing a point, the points outside of the level are stored in the nearest cell.
+	* @param x X coordinate in pixels.
+	* @param y Y coordinate in pixels.
+	* @return The cell index (it does not take the entity kind into account).
+	*/
+	static inline int _getCellIndex(int x, int y)
+	{
+		int xCell = x / CELL_SIZE_PIXELS, yCell = y / CELL_SIZE_PIXELS;
+		
+		if (xCell < 0) xCell = 0;
+		else if (xCell >= _levelWidthCells) xCell = _levelWidthCells - 1;
+		if (yCell < 0) yCell = 0;
+		else if (yCell >= _levelHeightCells) yCell = _levelHeightCells - 1;
+		
+		return (yCell * _levelWidthCells) + xCell;
+	}
+
+	/** Append a node to the beginning of its cell list.
+	* @param nodeIndex The node to store, its entity kind and cell must be set.
+	*/
+	static void _linkNode(int nodeIndex)
+	{
+		Node *pointerNode = &_nodes[nodeIndex];
+		int *pointerFirstNodeIndex = &_cellFirstNodeIndexes[(pointerNode->entityType * _levelWidthCells * _levelHeightCells) + pointerNode->cellIndex];
+		
+		pointerNode->previousNodeIndex = -1;
+		pointerNode->nextNodeIndex = *pointerFirstNodeIndex;
+		if (*pointerFirstNodeIndex != -1) _nodes[*pointerFirstNodeIndex].previousNodeIndex = nodeIndex;
+		*pointerFirstNodeIndex = nodeIndex;
+	}
+
+	/** Remove a node from its cell list.
+	* @param nodeIndex The node to remove.
+	*/
+	static void _unlinkNode(int nodeIndex)
+	{
+		Node *pointerNode = &_nodes[nodeIndex];
+		
+		if (pointerNode->previousNodeIndex == -1) _cellFirstNodeIndexes[(pointerNode->entityType * _levelWidthCells * _levelHeightCells) + pointerNode->cellIndex] = pointerNode->nextNodeIndex;
+		else _nodes[pointerNode->previousNodeIndex].nextNodeIndex = pointerNode->nextNodeIndex;
+		if (pointerNode->nextNodeIndex != -1) _nodes[pointerNode->nextNodeIndex].previousNodeIndex = pointerNode->previousNodeIndex;
+	}
+
+	void loadLevel(int levelWidthBlocks, int levelHeightBlocks)
+	{
+		_levelWidthCells = (levelWidthBlocks + CONFIGURATION_VISIBILITY_CELL_SIZE - 1) / CONFIGURATION_VISIBILITY_CELL_SIZE;
+		_levelHeightCells = (levelHeightBlocks + CONFIGURATION_VISIBILITY_CELL_SIZE - 1) / CONFIGURATION_VISIBILITY_CELL_SIZE;
+		_cellFirstNodeIndexes.assign(ENTITY_TYPES_COUNT * _levelWidthCells * _levelHeightCells, -1);
+		
+		_nodes.clear();
+		_firstFreeNodeIndex = -1;
+	}
+
+	void addEntity(Entity *pointerEntity, EntityType entityType)
+	{
+		int nodeIndex;
+		
+		// Nothing is rendered in headless mode
+		if (Renderer::isHeadlessModeEnabled) return;
+		
+		// Recycle a free node if possible
+		if (_firstFreeNodeIndex != -1)
+		{
+			nodeIndex = _firstFreeNodeIndex;
+			_firstFreeNodeIndex = _nodes[nodeIndex].nextNodeIndex;
+		}
+		else
+		{
+			nodeIndex = _nodes.size();
+			_nodes.resize(nodeIndex + 1);
+		}
+		
+		Node *pointerNode = &_nodes[nodeIndex];
+		pointerNode->pointerEntity = pointerEntity;
+		pointerNode->entityType = entityType;
+		pointerNode->cellIndex = _getCellIndex(pointerEntity->getX(), pointerEntity->getY());
+		_linkNode(nodeIndex);
+		pointerEntity->visibilityNodeIndex = nodeIndex;
+	}
+
+	void updateEntity(Entity *pointerEntity)
+	{
+		int nodeIndex = pointerEntity->visibilityNodeIndex;
+		if (nodeIndex == -1) return;
+		
+		// Most moves stay in the same cell
+		int cellIndex = _getCellIndex(pointerEntity->getX(), pointerEntity->getY());
+		if (cellIndex == _nodes[nodeIndex].cellIndex) return;
+		
+		_unlinkNode(nodeIndex);
+		_nodes[nodeIndex].cellIndex = cellIndex;
+		_linkNode(nodeIndex);
+	}
+
+	void removeEntity(Entity *pointerEntity)
+	{
+		int nodeIndex = pointerEntity->visibilityNodeIndex;
+		if (nodeIndex == -1) return;
+		
+		// The nodes of the previous level do not exist anymore
+		if ((nodeIndex < (int) _nodes.size()) && (_nodes[nodeIndex].pointerEntity == pointerEntity))
+		{
+			_unlinkNode(nodeIndex);
+			_nodes[nodeIndex].pointerEntity = NULL;
+			_nodes[nodeIndex].nextNodeIndex = _firstFreeNodeIndex;
+			_firstFreeNodeIndex = nodeIndex;
+		}
+		pointerEntity->visibilityNodeIndex = -1;
+	}
+
+	void renderEntities(EntityType entityType)
+	{
+		int xCell, yCell, firstXCell, firstYCell, lastXCell, lastYCell, nodeIndex, nextNodeIndex;
+		
+		if (_levelWidthCells == 0) return;
+		
+		// The entities stored in the cells above and on the left of the display can overlap it, and the displayed position of a moving entity can be a bit behind its position
+		firstXCell = (Renderer::displayX / CELL_SIZE_PIXELS) - 1;
+		if (firstXCell < 0) firstXCell = 0;
+		firstYCell = (Renderer::displayY / CELL_SIZE_PIXELS) - 1;
+		if (firstYCell < 0) firstYCell = 0;
+		lastXCell = (Renderer::displayX + Renderer::displayWidth) / CELL_SIZE_PIXELS;
+		if (lastXCell >= _levelWidthCells) lastXCell = _levelWidthCells - 1;
+		lastYCell = (Renderer::displayY + Renderer::displayHeight) / CELL_SIZE_PIXELS;
+		if (lastYCell >= _levelHeightCells) lastYCell = _levelHeightCells - 1;
+		
+		int *pointerCellFirstNodeIndexes = &_cellFirstNodeIndexes[entityType * _levelWidthCells * _levelHeightCells];
+		for (yCell = firstYCell; yCell <= lastYCell; yCell++)
+		{
+			for (xCell = firstXCell; xCell <= lastXCell; xCell++)
+			{
+				nodeIndex = pointerCellFirstNodeIndexes[(yCell * _levelWidthCells) + xCell];
+				while (nodeIndex != -1)
+				{
+					nextNodeIndex = _nodes[nodeIndex].nextNodeIndex; // Rendering can't remove an entity, but read the next node first anyway
+					_nodes[nodeIndex].pointerEntity->render();
+					nodeIndex = nextNodeIndex;
+				}
+			}
+		}
+	}
+}